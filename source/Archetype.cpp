@@ -0,0 +1,199 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Thing.hpp"
+#include "Thing.inl"
+#include "Archetype.inl"
+#include <algorithm>
+
+
+namespace Langulus::Entity
+{
+
+   /// Get the sorted concrete unit types of the archetype                    
+   ///   @return the types, one for each column                               
+   auto Archetype::GetTypes() const noexcept -> const ::std::vector<DMeta>& {
+      return mTypes;
+   }
+
+   /// Get the number of Things in the archetype                              
+   ///   @return the number of rows                                           
+   Count Archetype::GetCount() const noexcept {
+      return mOwners.size();
+   }
+
+   /// Find a column, whose units are of the given type, or derive from it    
+   ///   @param type - the type of units to search for                        
+   ///   @param nth - which of the matching columns to get                    
+   ///   @return the column index, or the number of columns if not found      
+   auto Archetype::GetColumnIndex(DMeta type, Offset nth) const noexcept -> Offset {
+      for (Offset i = 0; i < mTypes.size(); ++i) {
+         if (not mTypes[i]->CastsTo(type))
+            continue;
+         if (not nth)
+            return i;
+         --nth;
+      }
+
+      return mTypes.size();
+   }
+
+   /// Check if archetype has a column for each of the required types         
+   ///   @param required - the types to check                                 
+   ///   @return true if all types are present                                
+   bool Archetype::Contains(const ::std::vector<DMeta>& required) const noexcept {
+      for (auto type : required) {
+         if (GetColumnIndex(type) == mTypes.size())
+            return false;
+      }
+
+      return true;
+   }
+
+   /// Get the Things in the chunk                                            
+   ///   @return the Things, one for each row                                 
+   auto ArchetypeChunk::GetOwners() const noexcept -> ::std::span<Thing* const> {
+      return {mArchetype->mOwners.data() + mStart, mCount};
+   }
+
+   /// Get a column of units in the chunk                                     
+   ///   @param type - the type of units                                      
+   ///   @param nth - which of the matching columns to get                    
+   ///   @return the units, or an empty span if archetype has no such column  
+   auto ArchetypeChunk::GetColumn(DMeta type, Offset nth) const noexcept -> ::std::span<A::Unit* const> {
+      const auto column = mArchetype->GetColumnIndex(type, nth);
+      if (column == mArchetype->mTypes.size())
+         return {};
+      return {mArchetype->mColumns[column].data() + mStart, mCount};
+   }
+
+   /// Move a Thing to the archetype, that corresponds to its current units   
+   /// If the set of unit types didn't change, the row is refreshed in place  
+   ///   @param thing - the thing to update                                   
+   void Archetypes::Update(Thing* thing) {
+      LANGULUS_ASSUME(DevAssumes, thing, "Invalid thing");
+
+      // Gather the units, sorted by concrete type. Things have only    
+      // a few units, so an insertion sort is used - it's stable, so    
+      // units of the same type stay in order of addition               
+      auto& row = mRow;
+      row.clear();
+      for (auto unit : thing->GetUnits()) {
+         const ::std::pair<DMeta, A::Unit*> cell {unit->GetType(), unit};
+         auto at = row.size();
+         row.push_back(cell);
+         while (at and &*row[at - 1].first > &*cell.first) {
+            row[at] = row[at - 1];
+            --at;
+         }
+         row[at] = cell;
+      }
+
+      const auto found = mLocations.find(thing);
+      if (row.empty()) {
+         if (found != mLocations.end()) {
+            RemoveRow(found->second);
+            mLocations.erase(found);
+         }
+         return;
+      }
+
+      if (found != mLocations.end()) {
+         const auto current = found->second.mArchetype;
+         const bool same = current->mTypes.size() == row.size()
+            and ::std::equal(row.begin(), row.end(), current->mTypes.begin(),
+               [](const auto& cell, DMeta type) { return cell.first == type; });
+
+         if (same) {
+            // Same archetype, just refresh the unit pointers           
+            for (Offset i = 0; i < row.size(); ++i)
+               current->mColumns[i][found->second.mRow] = row[i].second;
+            return;
+         }
+      }
+
+      // Find or create the new archetype                               
+      mSignature.clear();
+      for (auto& cell : row)
+         mSignature.push_back(&*cell.first);
+
+      auto& slot = mArchetypes[mSignature];
+      if (not slot) {
+         slot = ::std::make_unique<Archetype>();
+         slot->mTypes.reserve(row.size());
+         for (auto& cell : row)
+            slot->mTypes.push_back(cell.first);
+         slot->mColumns.resize(row.size());
+      }
+
+      auto archetype = slot.get();
+      if (found != mLocations.end())
+         RemoveRow(found->second);
+
+      // Append to the new archetype                                    
+      archetype->mOwners.push_back(thing);
+      for (Offset i = 0; i < row.size(); ++i)
+         archetype->mColumns[i].push_back(row[i].second);
+      mLocations[thing] = {archetype, archetype->mOwners.size() - 1};
+   }
+
+   /// Forget about a Thing                                                   
+   ///   @param thing - the thing to remove                                   
+   void Archetypes::Remove(const Thing* thing) {
+      const auto found = mLocations.find(thing);
+      if (found == mLocations.end())
+         return;
+
+      RemoveRow(found->second);
+      mLocations.erase(found);
+   }
+
+   /// Remove a row by swapping the last row in its place                     
+   ///   @param location - the row to remove                                  
+   void Archetypes::RemoveRow(const Location& location) {
+      auto archetype = location.mArchetype;
+      const auto last = archetype->mOwners.size() - 1;
+      if (location.mRow != last) {
+         auto moved = archetype->mOwners[last];
+         archetype->mOwners[location.mRow] = moved;
+         for (auto& column : archetype->mColumns)
+            column[location.mRow] = column[last];
+         mLocations[moved].mRow = location.mRow;
+      }
+
+      archetype->mOwners.pop_back();
+      for (auto& column : archetype->mColumns)
+         column.pop_back();
+
+      if (archetype->mOwners.empty())
+         Prune(archetype);
+   }
+
+   /// Destroy an empty archetype                                             
+   ///   @param archetype - the archetype to destroy                          
+   void Archetypes::Prune(Archetype* archetype) {
+      mSignature.clear();
+      for (auto type : archetype->mTypes)
+         mSignature.push_back(&*type);
+      mArchetypes.erase(mArchetypes.find(mSignature));
+   }
+
+   /// Get the archetype a Thing is currently in                              
+   ///   @param thing - the thing to search for                               
+   ///   @return the archetype, or nullptr if thing isn't tracked             
+   auto Archetypes::GetArchetype(const Thing* thing) const noexcept -> const Archetype* {
+      const auto found = mLocations.find(thing);
+      return found != mLocations.end() ? found->second.mArchetype : nullptr;
+   }
+
+   /// Get the number of archetypes, that contain any Things                  
+   ///   @return the number of archetypes                                     
+   Count Archetypes::GetArchetypeCount() const noexcept {
+      return mArchetypes.size();
+   }
+
+} // namespace Langulus::Entity
@@ -0,0 +1,121 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Unit.hpp"
+#include <map>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Langulus::Entity
+{
+
+   class Thing;
+
+
+   ///                                                                        
+   ///   Archetype                                                            
+   ///                                                                        
+   ///   A group of Things, that have the exact same set of unit types. Each  
+   /// Thing is a row, and each unit type is a column of unit pointers, so    
+   /// that iterating units of the same type is a walk over contiguous        
+   /// memory, instead of hopping through every Thing's unit maps.            
+   ///   Units are polymorphic and owned by their Things, so columns contain  
+   /// pointers, and never the units themselves.                              
+   ///                                                                        
+   class Archetype final {
+      friend class Archetypes;
+
+      // Concrete unit types, one for each column, sorted by type       
+      ::std::vector<DMeta> mTypes;
+      // The Thing in each row                                          
+      ::std::vector<Thing*> mOwners;
+      // Unit columns, one for each type in mTypes                      
+      ::std::vector<::std::vector<A::Unit*>> mColumns;
+
+   public:
+      NOD() LANGULUS_API(ENTITY)
+      auto GetTypes() const noexcept -> const ::std::vector<DMeta>&;
+      NOD() LANGULUS_API(ENTITY)
+      Count GetCount() const noexcept;
+      NOD() LANGULUS_API(ENTITY)
+      auto GetColumnIndex(DMeta, Offset = 0) const noexcept -> Offset;
+      NOD() LANGULUS_API(ENTITY)
+      bool Contains(const ::std::vector<DMeta>&) const noexcept;
+   };
+
+
+   ///                                                                        
+   ///   A contiguous range of rows inside an archetype                       
+   ///                                                                        
+   struct ArchetypeChunk {
+      // The archetype the chunk is part of                             
+      const Archetype* mArchetype {};
+      // The first row of the chunk                                     
+      Offset mStart {};
+      // The number of rows in the chunk                                
+      Count mCount {};
+
+      NOD() LANGULUS_API(ENTITY)
+      auto GetOwners() const noexcept -> ::std::span<Thing* const>;
+      NOD() LANGULUS_API(ENTITY)
+      auto GetColumn(DMeta, Offset = 0) const noexcept -> ::std::span<A::Unit* const>;
+
+      template<CT::Unit T> NOD()
+      auto GetColumn(Offset = 0) const noexcept -> ::std::span<A::Unit* const>;
+   };
+
+
+   ///                                                                        
+   ///   Archetype storage                                                    
+   ///                                                                        
+   ///   An optional layer in a Runtime, that keeps track of the archetype    
+   /// of each Thing with units, and gives chunked access to all Things that  
+   /// have a given set of unit types.                                        
+   ///   Archetypes that become empty are destroyed. Updating a Thing, whose  
+   /// unit types didn't change, neither allocates nor searches archetypes.   
+   ///                                                                        
+   class Archetypes final {
+   public:
+      /// Maximum number of rows in a single chunk                            
+      static constexpr Count ChunkSize = 256;
+
+   private:
+      /// Where a Thing is stored                                             
+      struct Location {
+         Archetype* mArchetype {};
+         Offset mRow {};
+      };
+
+      // All archetypes, indexed by their sorted unit types             
+      ::std::map<::std::vector<const void*>, ::std::unique_ptr<Archetype>> mArchetypes;
+      // Where each Thing is stored                                     
+      ::std::unordered_map<const Thing*, Location> mLocations;
+      // Reused buffers for the sorted units of a Thing and their types 
+      ::std::vector<::std::pair<DMeta, A::Unit*>> mRow;
+      ::std::vector<const void*> mSignature;
+
+      void RemoveRow(const Location&);
+      void Prune(Archetype*);
+
+   public:
+      LANGULUS_API(ENTITY) void Update(Thing*);
+      LANGULUS_API(ENTITY) void Remove(const Thing*);
+
+      NOD() LANGULUS_API(ENTITY)
+      auto GetArchetype(const Thing*) const noexcept -> const Archetype*;
+      NOD() LANGULUS_API(ENTITY)
+      Count GetArchetypeCount() const noexcept;
+
+      template<class F>
+      Count ForEachChunk(const ::std::vector<DMeta>&, F&&) const;
+   };
+
+} // namespace Langulus::Entity
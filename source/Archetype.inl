@@ -0,0 +1,52 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Archetype.hpp"
+
+
+namespace Langulus::Entity
+{
+
+   /// Get the column of units of a static type                               
+   ///   @tparam T - the type of units                                        
+   ///   @param nth - which of the matching columns to get                    
+   ///   @return the units, or an empty span if archetype has no such column  
+   template<CT::Unit T> LANGULUS(INLINED)
+   auto ArchetypeChunk::GetColumn(Offset nth) const noexcept -> ::std::span<A::Unit* const> {
+      return GetColumn(MetaDataOf<Decay<T>>(), nth);
+   }
+
+   /// Visit all chunks of all archetypes, that contain the required types    
+   ///   @param required - the unit types that archetypes must contain        
+   ///   @param call - the visitor, receives a const ArchetypeChunk&, and     
+   ///      may return void, bool or LoopControl                              
+   ///   @return the number of visited chunks                                 
+   template<class F>
+   Count Archetypes::ForEachChunk(const ::std::vector<DMeta>& required, F&& call) const {
+      Count visited = 0;
+      for (auto& pair : mArchetypes) {
+         const auto& archetype = *pair.second;
+         if (not archetype.Contains(required))
+            continue;
+
+         const auto count = archetype.GetCount();
+         for (Offset start = 0; start < count; start += ChunkSize) {
+            const ArchetypeChunk chunk {
+               &archetype, start, ::std::min(ChunkSize, count - start)
+            };
+
+            ++visited;
+            if (not Visit(call, chunk))
+               return visited;
+         }
+      }
+
+      return visited;
+   }
+
+} // namespace Langulus::Entity
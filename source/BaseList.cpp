@@ -0,0 +1,108 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "BaseList.hpp"
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Langulus::Entity
+{
+
+   /// A type and the base at which its traversal stops                       
+   struct BaseListKey {
+      const void* mType;
+      const void* mStop;
+
+      bool operator == (const BaseListKey&) const noexcept = default;
+   };
+
+   struct BaseListKeyHash {
+      size_t operator () (const BaseListKey& key) const noexcept {
+         return ::std::hash<const void*> {}(key.mType)
+            ^ (::std::hash<const void*> {}(key.mStop) << 1);
+      }
+   };
+
+   /// A cached base list, and the generation it was built in. Lists are      
+   /// allocated separately, so they don't move when the cache rehashes       
+   struct BaseListEntry {
+      ::std::unique_ptr<const BaseList> mList;
+      Count mGeneration;
+   };
+
+   static ::std::unordered_map<BaseListKey, BaseListEntry, BaseListKeyHash> gBaseLists;
+   /// Lists, that were rebuilt after a reset. They are kept alive, because   
+   /// a caller may still be iterating one                                    
+   static ::std::vector<::std::unique_ptr<const BaseList>> gStaleBaseLists;
+   /// Incremented by ResetBaseLists, to invalidate all cached lists          
+   static Count gBaseListsGeneration = 0;
+   static ::std::shared_mutex gBaseListsMutex;
+
+   /// Recursively flatten the bases of a type                                
+   ///   @param list - [in/out] the list to fill                              
+   ///   @param type - the type to add, along with its bases                  
+   ///   @param isStop - checks if a base is where traversal stops            
+   static void Flatten(BaseList& list, DMeta type, bool(*isStop)(DMeta)) {
+      if (::std::find(list.begin(), list.end(), type) == list.end())
+         list.push_back(type);
+
+      for (auto& base : type->mBases) {
+         if (isStop(base.mType))
+            break;
+         Flatten(list, base.mType, isStop);
+      }
+   }
+
+   /// Get a type and all of its bases in a flat list, stopping at a base     
+   ///   @attention a reference taken before ResetBaseLists stays valid, but  
+   ///              may list types that are no longer reflected               
+   ///   @param type - the type to get bases of                               
+   ///   @param stop - the base at which traversal stops, used as cache key   
+   ///   @param isStop - checks if a base is where traversal stops            
+   ///   @return the type, followed by its bases                              
+   auto GetBaseList(DMeta type, DMeta stop, bool(*isStop)(DMeta)) -> const BaseList& {
+      const BaseListKey key {&*type, &*stop};
+      {
+         ::std::shared_lock lock {gBaseListsMutex};
+         const auto found = gBaseLists.find(key);
+         if (found != gBaseLists.end()
+         and found->second.mGeneration == gBaseListsGeneration)
+            return *found->second.mList;
+      }
+
+      auto list = ::std::make_unique<BaseList>();
+      Flatten(*list, type, isStop);
+
+      ::std::unique_lock lock {gBaseListsMutex};
+      auto& entry = gBaseLists[key];
+      if (entry.mList and entry.mGeneration == gBaseListsGeneration)
+         return *entry.mList;
+
+      // Retire the list from an older generation, instead of freeing it
+      if (entry.mList)
+         gStaleBaseLists.emplace_back(::std::move(entry.mList));
+      entry.mList = ::std::move(list);
+      entry.mGeneration = gBaseListsGeneration;
+      return *entry.mList;
+   }
+
+   /// Invalidate all cached base lists. Must be called whenever reflected    
+   /// types might be unloaded, along with the shared library that defined    
+   /// them. The lists are rebuilt on their next request, and the old ones    
+   /// are kept, so that references to them never dangle                      
+   void ResetBaseLists() {
+      ::std::unique_lock lock {gBaseListsMutex};
+      ++gBaseListsGeneration;
+   }
+
+} // namespace Langulus::Entity
@@ -0,0 +1,40 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Common.hpp"
+#include <vector>
+
+
+namespace Langulus::Entity
+{
+
+   /// A type, followed by all of its relevant bases, without duplicates      
+   using BaseList = ::std::vector<DMeta>;
+
+   NOD() LANGULUS_API(ENTITY)
+   auto GetBaseList(DMeta, DMeta, bool(*)(DMeta)) -> const BaseList&;
+
+   LANGULUS_API(ENTITY)
+   void ResetBaseLists();
+
+   /// Get a type and all of its bases in a flat list, in the order they      
+   /// would be visited recursively, stopping at the STOP base. Lists are     
+   /// built once per type, and rebuilt after a shared library is unloaded    
+   ///   @attention the returned list stays valid after ResetBaseLists, but   
+   ///              may list types that are no longer reflected               
+   ///   @tparam STOP - the base at which traversal stops, excluded           
+   ///   @param type - the type to get bases of                               
+   ///   @return the type, followed by its bases                              
+   template<class STOP> NOD() LANGULUS(INLINED)
+   auto GetBaseList(DMeta type) -> const BaseList& {
+      return GetBaseList(type, MetaDataOf<STOP>(), [](DMeta base) {
+         return base->template IsExact<STOP>();
+      });
+   }
+
+} // namespace Langulus::Entity
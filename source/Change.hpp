@@ -0,0 +1,51 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Common.hpp"
+#include <functional>
+
+
+namespace Langulus::A
+{
+   struct Unit;
+}
+
+namespace Langulus::Entity
+{
+
+   class Thing;
+
+
+   ///                                                                        
+   ///   A change in a Thing, as reported to runtime observers                
+   ///                                                                        
+   struct Change {
+      enum Kind : uint8_t {
+         UnitAdded, UnitRemoved,
+         TraitAdded, TraitRemoved, TraitChanged,
+         ChildAttached, ChildDetached
+      };
+
+      // What happened                                                  
+      Kind mKind;
+      // The Thing that changed                                         
+      Thing* mThing;
+      // The added or removed unit, if any                              
+      A::Unit* mUnit {};
+      // The type of the added, removed or changed trait, if any        
+      TMeta mTrait {};
+      // The attached or detached child, if any                         
+      Thing* mChild {};
+   };
+
+   /// An observer is invoked for each change, right after it happens,        
+   /// except for removals, which are reported right before they happen,      
+   /// so that the removed unit or child is still valid                       
+   using Observer = ::std::function<void(const Change&)>;
+
+} // namespace Langulus::Entity
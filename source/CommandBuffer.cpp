@@ -0,0 +1,155 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Thing.hpp"
+#include "Thing.inl"
+
+
+namespace Langulus::Entity
+{
+
+   CommandBuffer::CommandBuffer() = default;
+
+   /// Destroying the buffer discards all commands, that weren't flushed      
+   CommandBuffer::~CommandBuffer() = default;
+
+   /// Record a command                                                       
+   ///   @param command - [in/out] the command to record, gets abandoned      
+   void CommandBuffer::Push(Command& command) {
+      ::std::scoped_lock lock {mMutex};
+      mCommands << Abandon(command);
+   }
+
+   /// Record the creation of a child                                         
+   ///   @param parent - the Thing to create the child in                     
+   ///   @param descriptor - instructions for the child's creation            
+   void CommandBuffer::CreateChild(Thing* parent, Many&& descriptor) {
+      LANGULUS_ASSUME(UserAssumes, parent, "Invalid parent");
+      Command command {Kind::CreateChild};
+      command.mThing = parent;
+      command.mDescriptor = Move(descriptor);
+      Push(command);
+   }
+
+   /// Record the destruction of a Thing, by detaching it from its owner      
+   ///   @param thing - the Thing to destroy                                  
+   void CommandBuffer::Destroy(Thing* thing) {
+      LANGULUS_ASSUME(UserAssumes, thing, "Invalid thing");
+      Command command {Kind::Destroy};
+      command.mThing = thing;
+      Push(command);
+   }
+
+   /// Record the addition of a unit                                          
+   ///   @param thing - the Thing to add the unit to                          
+   ///   @param unit - the unit to add                                        
+   void CommandBuffer::AddUnit(Thing* thing, A::Unit* unit) {
+      LANGULUS_ASSUME(UserAssumes, thing and unit, "Invalid thing or unit");
+      Command command {Kind::AddUnit};
+      command.mThing = thing;
+      command.mUnit = unit;
+      Push(command);
+   }
+
+   /// Record the removal of a unit                                           
+   ///   @param thing - the Thing to remove the unit from                     
+   ///   @param unit - the unit to remove                                     
+   void CommandBuffer::RemoveUnit(Thing* thing, A::Unit* unit) {
+      LANGULUS_ASSUME(UserAssumes, thing and unit, "Invalid thing or unit");
+      Command command {Kind::RemoveUnit};
+      command.mThing = thing;
+      command.mUnit = unit;
+      Push(command);
+   }
+
+   /// Record the addition of a trait                                         
+   ///   @param thing - the Thing to add the trait to                         
+   ///   @param trait - the trait to add                                      
+   void CommandBuffer::AddTrait(Thing* thing, Trait trait) {
+      LANGULUS_ASSUME(UserAssumes, thing, "Invalid thing");
+      Command command {Kind::AddTrait};
+      command.mThing = thing;
+      command.mTrait = Move(trait);
+      Push(command);
+   }
+
+   /// Record the removal of all traits of a type                             
+   ///   @param thing - the Thing to remove the traits from                   
+   ///   @param type - the type of traits to remove                           
+   void CommandBuffer::RemoveTrait(Thing* thing, TMeta type) {
+      LANGULUS_ASSUME(UserAssumes, thing, "Invalid thing");
+      Command command {Kind::RemoveTrait};
+      command.mThing = thing;
+      command.mTraitType = type;
+      Push(command);
+   }
+
+   /// Get the number of recorded commands, that weren't flushed yet          
+   ///   @return the number of commands                                       
+   Count CommandBuffer::GetCount() const {
+      ::std::scoped_lock lock {mMutex};
+      return mCommands.GetCount();
+   }
+
+   /// Apply all recorded commands, in order of recording                     
+   /// Commands recorded while flushing are applied on the next flush         
+   ///   @return the number of applied commands                               
+   Count CommandBuffer::Flush() {
+      TMany<Command> commands;
+      {
+         ::std::scoped_lock lock {mMutex};
+         commands = Move(mCommands);
+      }
+
+      // Reference everything here, on the flushing thread, because an  
+      // earlier command might release what a later command changes     
+      TMany<Ref<Thing>> things;
+      TMany<Ref<A::Unit>> units;
+      for (auto& command : commands) {
+         things << Ref<Thing> {command.mThing};
+         if (command.mUnit)
+            units << Ref<A::Unit> {command.mUnit};
+      }
+
+      Count applied = 0;
+      for (auto& command : commands) {
+         auto thing = command.mThing;
+
+         try {
+            switch (command.mKind) {
+            case Kind::CreateChild:
+               (void) thing->CreateChild(Move(command.mDescriptor));
+               break;
+            case Kind::Destroy:
+               if (thing->GetOwner())
+                  const_cast<Thing*>(&*thing->GetOwner())->RemoveChild(thing);
+               break;
+            case Kind::AddUnit:
+               thing->AddUnit(command.mUnit);
+               break;
+            case Kind::RemoveUnit:
+               thing->RemoveUnit(command.mUnit);
+               break;
+            case Kind::AddTrait:
+               thing->AddTrait(Move(command.mTrait));
+               break;
+            case Kind::RemoveTrait:
+               thing->RemoveTrait(command.mTraitType);
+               break;
+            }
+
+            ++applied;
+         }
+         catch (...) {
+            Logger::Error("Deferred command on ", *thing, " failed");
+         }
+      }
+
+      return applied;
+   }
+
+} // namespace Langulus::Entity
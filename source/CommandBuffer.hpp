@@ -0,0 +1,84 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Unit.hpp"
+#include <mutex>
+
+
+namespace Langulus::Entity
+{
+
+   class Thing;
+
+
+   ///                                                                        
+   ///   Command buffer                                                       
+   ///                                                                        
+   ///   Records structural changes to a hierarchy - creating and destroying  
+   /// children, adding and removing units and traits - so that they can be   
+   /// requested while the hierarchy is being iterated, even from worker      
+   /// threads. Recorded commands are applied in order of recording, in a     
+   /// single pass, when the buffer is flushed. A Runtime flushes its buffer  
+   /// at the end of its owner's Thing::Update, once per frame.               
+   ///   Reference counts aren't atomic, so recording never touches them -    
+   /// commands hold raw pointers, and the flushing thread references all of  
+   /// them before applying any. Recorded Things and units must be kept alive 
+   /// until the next flush, which is the case for anything in a hierarchy    
+   /// that is being updated.                                                 
+   ///                                                                        
+   class CommandBuffer final {
+   public:
+      enum class Kind {
+         CreateChild, Destroy, AddUnit, RemoveUnit, AddTrait, RemoveTrait
+      };
+
+   private:
+      /// A recorded command                                                  
+      struct Command {
+         Kind mKind;
+         // The Thing to change                                         
+         Thing* mThing {};
+         // The unit to add or remove                                   
+         A::Unit* mUnit {};
+         // Creation descriptor for a new child                         
+         Many mDescriptor;
+         // The trait to add                                            
+         Trait mTrait;
+         // The type of traits to remove                                
+         TMeta mTraitType;
+      };
+
+      // Recorded commands, in order of recording                       
+      TMany<Command> mCommands;
+      // Guards mCommands, commands can be recorded from any thread     
+      mutable ::std::mutex mMutex;
+
+      void Push(Command&);
+
+   public:
+      LANGULUS_API(ENTITY)  CommandBuffer();
+      LANGULUS_API(ENTITY) ~CommandBuffer();
+
+      CommandBuffer(const CommandBuffer&) = delete;
+      CommandBuffer& operator = (const CommandBuffer&) = delete;
+
+      LANGULUS_API(ENTITY) void CreateChild(Thing*, Many&& = {});
+      LANGULUS_API(ENTITY) void Destroy(Thing*);
+      LANGULUS_API(ENTITY) void AddUnit(Thing*, A::Unit*);
+      LANGULUS_API(ENTITY) void RemoveUnit(Thing*, A::Unit*);
+      LANGULUS_API(ENTITY) void AddTrait(Thing*, Trait);
+      LANGULUS_API(ENTITY) void RemoveTrait(Thing*, TMeta);
+
+      NOD() LANGULUS_API(ENTITY)
+      Count GetCount() const;
+
+      LANGULUS_API(ENTITY)
+      Count Flush();
+   };
+
+} // namespace Langulus::Entity
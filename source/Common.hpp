@@ -30,6 +30,28 @@ namespace Langulus
 
 } // namespace Langulus::Entity
 
+namespace Langulus::Entity
+{
+
+   /// Invoke a visitor, that may return void, bool, or LoopControl           
+   ///   @param call - the visitor to invoke                                  
+   ///   @param args - the arguments to forward to the visitor                
+   ///   @return false if the visitor requested to break the loop             
+   template<class F, class...A> LANGULUS(INLINED)
+   bool Visit(F&& call, A&&...args) {
+      using R = decltype(call(Forward<A>(args)...));
+      if constexpr (::std::is_void_v<R>) {
+         call(Forward<A>(args)...);
+         return true;
+      }
+      else if constexpr (CT::Same<R, bool>)
+         return call(Forward<A>(args)...);
+      else
+         return call(Forward<A>(args)...) != Loop::Break;
+   }
+
+} // namespace Langulus::Entity
+
 
 /// Make the rest of the code aware, that Langulus::Entity has been included  
 #define LANGULUS_LIBRARY_ENTITY() 1
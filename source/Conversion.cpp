@@ -0,0 +1,78 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Conversion.hpp"
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+
+namespace Langulus::Entity
+{
+
+   /// A pair of types to convert between                                     
+   struct ConversionKey {
+      const void* mFrom;
+      const void* mTo;
+
+      bool operator == (const ConversionKey&) const noexcept = default;
+   };
+
+   struct ConversionKeyHash {
+      size_t operator () (const ConversionKey& key) const noexcept {
+         return ::std::hash<const void*> {}(key.mFrom)
+            ^ (::std::hash<const void*> {}(key.mTo) << 1);
+      }
+   };
+
+   /// Cached conversion verdicts                                             
+   static ::std::unordered_map<ConversionKey, Conversion, ConversionKeyHash> gConversions;
+   static ::std::shared_mutex gConversionsMutex;
+
+   /// Get the verdict on converting one type to another                      
+   ///   @param from - the type to convert from                               
+   ///   @param to - the type to convert to                                   
+   ///   @return the verdict, Conversion::Unknown if none was made yet        
+   auto GetConversion(DMeta from, DMeta to) -> Conversion {
+      ::std::shared_lock lock {gConversionsMutex};
+      const auto found = gConversions.find({&*from, &*to});
+      return found != gConversions.end() ? found->second : Conversion::Unknown;
+   }
+
+   /// Remember the verdict on converting one type to another                 
+   ///   @param from - the type to convert from                               
+   ///   @param to - the type to convert to                                   
+   ///   @param verdict - the verdict                                         
+   void SetConversion(DMeta from, DMeta to, Conversion verdict) {
+      ::std::unique_lock lock {gConversionsMutex};
+      gConversions[{&*from, &*to}] = verdict;
+   }
+
+   /// Check if reflection has a way to convert one type to another           
+   /// Numbers convert to each other, and anything might convert to text,     
+   /// without reflecting a converter, so these are assumed to convert        
+   ///   @param from - the type to convert from                               
+   ///   @param to - the type to convert to                                   
+   ///   @return true if a conversion might exist                             
+   bool HasConverter(DMeta from, DMeta to) {
+      if (from->CastsTo(to) or to->Is<Text>())
+         return true;
+      if (from->CastsTo<A::Number>() and to->CastsTo<A::Number>())
+         return true;
+      return from->mConverters.find(to) != from->mConverters.end();
+   }
+
+   /// Forget all conversion verdicts. Must be called whenever reflected      
+   /// types might be unloaded, along with the shared library that defined    
+   /// them, or their converters                                              
+   void ResetConversions() {
+      ::std::unique_lock lock {gConversionsMutex};
+      gConversions.clear();
+   }
+
+} // namespace Langulus::Entity
@@ -0,0 +1,120 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Common.hpp"
+
+
+namespace Langulus::Entity
+{
+
+   /// Verdict on whether one type converts to another                        
+   enum class Conversion : uint8_t {
+      // Not attempted yet                                              
+      Unknown,
+      // At least one conversion has succeeded                          
+      Possible,
+      // Conversion has failed, and never will succeed                  
+      Impossible
+   };
+
+   NOD() LANGULUS_API(ENTITY)
+   auto GetConversion(DMeta, DMeta) -> Conversion;
+
+   LANGULUS_API(ENTITY)
+   void SetConversion(DMeta, DMeta, Conversion);
+
+   LANGULUS_API(ENTITY)
+   void ResetConversions();
+
+   NOD() LANGULUS_API(ENTITY)
+   bool HasConverter(DMeta, DMeta);
+
+   /// Check if whether data converts depends only on its type, and not on    
+   /// its contents - that is, if data is a single dense element, that is     
+   /// neither text, nor a container of other data                            
+   ///   @param data - the data to check                                      
+   ///   @return true if a verdict for the type applies to the data           
+   NOD() inline
+   bool IsTypeDetermined(const Many& data) {
+      return data.GetCount() == 1 and not data.IsSparse()
+         and not data.IsDeep() and not data.Is<Text>();
+   }
+
+   /// Attempt converting data to a type, without throwing                    
+   /// Verdicts are made and used only for data, whose conversion is type     
+   /// determined. A failure is remembered as impossible, only if reflection  
+   /// has no converter between the types, so such pairs are rejected         
+   /// without attempting them. Anything else, that fails, depends on the     
+   /// contents, and is attempted every time                                  
+   ///   @attention only failures rejected by a cached verdict avoid an       
+   ///      exception - the conversion itself is made by AsCast, which finds  
+   ///      the converter on each call, and reports failures by throwing      
+   ///   @tparam T - the type to convert to                                   
+   ///   @param from - the data to convert                                    
+   ///   @param output - [out] the converted data                             
+   ///   @return true if output was rewritten                                 
+   template<class T>
+   bool TryConvert(const Many& from, T& output) {
+      const auto source = from.GetType();
+      if (not source or from.IsEmpty())
+         return false;
+
+      const auto target = MetaDataOf<T>();
+      const bool determined = IsTypeDetermined(from);
+      const auto verdict = determined
+         ? GetConversion(source, target) : Conversion::Unknown;
+      if (verdict == Conversion::Impossible)
+         return false;
+
+      try { output = from.template AsCast<T>(); }
+      catch (...) {
+         if (determined and not HasConverter(source, target))
+            SetConversion(source, target, Conversion::Impossible);
+         return false;
+      }
+
+      if (determined and verdict == Conversion::Unknown)
+         SetConversion(source, target, Conversion::Possible);
+      return true;
+   }
+
+   /// Attempt making a type from data, used as a descriptor, without         
+   /// throwing. Follows the same verdicts as TryConvert, but there's no      
+   /// reflection to consult, so any type determined failure is remembered    
+   ///   @attention like with TryConvert, only failures rejected by a cached  
+   ///      verdict avoid an exception                                        
+   ///   @tparam T - the type to make                                         
+   ///   @param from - the descriptor                                         
+   ///   @param output - [out] the made data                                  
+   ///   @return true if output was rewritten                                 
+   template<CT::DescriptorMakable T>
+   bool TryDescribe(const Many& from, T& output) {
+      const auto source = from.GetType();
+      if (not source or from.IsEmpty())
+         return false;
+
+      const auto target = MetaDataOf<T>();
+      const bool determined = IsTypeDetermined(from);
+      const auto verdict = determined
+         ? GetConversion(source, target) : Conversion::Unknown;
+      if (verdict == Conversion::Impossible)
+         return false;
+
+      try { output = T {Describe(from)}; }
+      catch (...) {
+         if (determined)
+            SetConversion(source, target, Conversion::Impossible);
+         return false;
+      }
+
+      if (determined and verdict == Conversion::Unknown)
+         SetConversion(source, target, Conversion::Possible);
+      return true;
+   }
+
+} // namespace Langulus::Entity
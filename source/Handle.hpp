@@ -0,0 +1,104 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Common.hpp"
+#include <shared_mutex>
+#include <vector>
+
+
+namespace Langulus::A
+{
+   struct Unit;
+}
+
+namespace Langulus::Entity
+{
+
+   class Thing;
+
+
+   ///                                                                        
+   ///   Generational handle                                                  
+   ///                                                                        
+   ///   A 32-bit reference to a Thing or a unit, issued by a Runtime. The    
+   /// low bits are an index into the runtime's handle table, the high bits   
+   /// are the generation of that slot. Once the referenced object leaves     
+   /// the runtime, the slot's generation changes, and the handle no longer   
+   /// resolves. Handles don't keep anything alive, so they can be cached     
+   /// across frames, sent to other threads and serialized as plain integers. 
+   ///                                                                        
+   template<class T>
+   struct THandle {
+      LANGULUS(POD) true;
+
+      static constexpr uint32_t IndexBits = 20;
+      static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+      static constexpr uint32_t MaxGeneration = (1u << (32 - IndexBits)) - 1;
+
+      // Generation in the high bits, index in the low bits             
+      // Generations start at one, so a zero handle is never valid      
+      uint32_t mValue {};
+
+      NOD() constexpr uint32_t GetIndex() const noexcept {
+         return mValue & IndexMask;
+      }
+
+      NOD() constexpr uint32_t GetGeneration() const noexcept {
+         return mValue >> IndexBits;
+      }
+
+      NOD() constexpr explicit operator bool() const noexcept {
+         return mValue != 0;
+      }
+
+      NOD() constexpr bool operator == (const THandle&) const noexcept = default;
+   };
+
+   using ThingHandle = THandle<Thing>;
+   using UnitHandle = THandle<A::Unit>;
+
+   static_assert(sizeof(ThingHandle) == 4, "Handles must be 32-bit");
+
+
+   ///                                                                        
+   ///   Handle table                                                         
+   ///                                                                        
+   ///   Maps handles to objects in O(1), and recycles the slots of released  
+   /// handles. Slots, whose generation is exhausted, are retired instead of  
+   /// recycled, so a stale handle never resolves to another object. Objects  
+   /// aren't referenced - they have to release their handles, when they      
+   /// leave the runtime.                                                     
+   ///                                                                        
+   template<class T>
+   class THandleTable final {
+      /// A slot in the table                                                 
+      struct Slot {
+         // The object, or nullptr if the slot is free                  
+         T* mObject {};
+         // The generation of the current or next handle to the slot    
+         uint32_t mGeneration {1};
+      };
+
+      // All slots, indexed by handle index                             
+      ::std::vector<Slot> mSlots;
+      // Indices of released slots, reused before making new ones       
+      ::std::vector<uint32_t> mFree;
+      // Number of issued handles                                       
+      Count mCount {};
+      // Guards the table, handles may be used from worker threads      
+      mutable ::std::shared_mutex mMutex;
+
+   public:
+      NOD() auto Issue(T*) -> THandle<T>;
+      void Release(THandle<T>);
+      void Rebind(THandle<T>, T*);
+      NOD() auto Resolve(THandle<T>) const -> T*;
+      NOD() Count GetCount() const;
+   };
+
+} // namespace Langulus::Entity
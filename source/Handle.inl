@@ -0,0 +1,103 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Handle.hpp"
+
+#define TEMPLATE()   template<class T>
+#define TABLE()      THandleTable<T>
+
+
+namespace Langulus::Entity
+{
+
+   /// Issue a new handle to an object                                        
+   ///   @param object - the object to refer to                               
+   ///   @return the handle                                                   
+   TEMPLATE()
+   auto TABLE()::Issue(T* object) -> THandle<T> {
+      LANGULUS_ASSUME(DevAssumes, object, "Invalid object");
+      ::std::unique_lock lock {mMutex};
+
+      uint32_t index;
+      if (not mFree.empty()) {
+         index = mFree.back();
+         mFree.pop_back();
+      }
+      else {
+         LANGULUS_ASSERT(mSlots.size() <= THandle<T>::IndexMask, Construct,
+            "Out of handles");
+         index = static_cast<uint32_t>(mSlots.size());
+         mSlots.emplace_back();
+      }
+
+      auto& slot = mSlots[index];
+      slot.mObject = object;
+      ++mCount;
+      return {(slot.mGeneration << THandle<T>::IndexBits) | index};
+   }
+
+   /// Release a handle, so that it no longer resolves                        
+   ///   @param handle - the handle to release, ignored if stale              
+   TEMPLATE()
+   void TABLE()::Release(THandle<T> handle) {
+      ::std::unique_lock lock {mMutex};
+      const auto index = handle.GetIndex();
+      if (index >= mSlots.size())
+         return;
+
+      auto& slot = mSlots[index];
+      if (not slot.mObject or slot.mGeneration != handle.GetGeneration())
+         return;
+
+      slot.mObject = nullptr;
+      --mCount;
+      if (slot.mGeneration < THandle<T>::MaxGeneration) {
+         ++slot.mGeneration;
+         mFree.push_back(index);
+      }
+      else slot.mGeneration = 0;
+   }
+
+   /// Make a handle refer to another object, when the object is moved        
+   ///   @param handle - the handle to change, ignored if stale               
+   ///   @param object - the new object                                       
+   TEMPLATE()
+   void TABLE()::Rebind(THandle<T> handle, T* object) {
+      ::std::unique_lock lock {mMutex};
+      const auto index = handle.GetIndex();
+      if (index < mSlots.size() and mSlots[index].mObject
+      and mSlots[index].mGeneration == handle.GetGeneration())
+         mSlots[index].mObject = object;
+   }
+
+   /// Get the object a handle refers to                                      
+   ///   @param handle - the handle                                           
+   ///   @return the object, or nullptr if handle is stale or invalid         
+   TEMPLATE()
+   auto TABLE()::Resolve(THandle<T> handle) const -> T* {
+      ::std::shared_lock lock {mMutex};
+      const auto index = handle.GetIndex();
+      if (index >= mSlots.size())
+         return nullptr;
+
+      const auto& slot = mSlots[index];
+      return slot.mGeneration == handle.GetGeneration() ? slot.mObject : nullptr;
+   }
+
+   /// Get the number of issued handles, that weren't released yet            
+   ///   @return the number of handles                                        
+   TEMPLATE()
+   Count TABLE()::GetCount() const {
+      ::std::shared_lock lock {mMutex};
+      return mCount;
+   }
+
+} // namespace Langulus::Entity
+
+#undef TEMPLATE
+#undef TABLE
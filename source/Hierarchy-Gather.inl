@@ -103,8 +103,9 @@ namespace Langulus::Entity
    template<Seek SEEK> LANGULUS(INLINED)
    TMany<A::Unit*> Hierarchy::GatherUnits(DMeta meta) {
       TMany<A::Unit*> result;
-      for (auto owner : *this)
-         result += owner->template GatherUnits<SEEK>(meta);
+      ForEachUnit<SEEK>(meta, [&](A::Unit* unit) {
+         result << unit;
+      });
       return Abandon(result);
    }
       
@@ -115,8 +116,9 @@ namespace Langulus::Entity
    template<Seek SEEK> LANGULUS(INLINED)
    TMany<Trait> Hierarchy::GatherTraits(TMeta trait) {
       TMany<Trait> result;
-      for (auto owner : *this)
-         result += owner->template GatherTraits<SEEK>(trait);
+      ForEachTrait<SEEK>(trait, [&](const Trait& found) {
+         result << found;
+      });
       return Abandon(result);
    }
 
@@ -132,4 +134,48 @@ namespace Langulus::Entity
       return Abandon(result);
    }
 
+   /// Visit all units of the given type inside the hierarchy, without        
+   /// collecting them in any intermediate container                          
+   ///   @tparam SEEK - where in the hierarchy are we seeking in?             
+   ///   @param meta - the units to seek for                                  
+   ///   @param call - the visitor, may return void, bool or LoopControl      
+   ///   @return the number of visited units                                  
+   template<Seek SEEK, class F> LANGULUS(INLINED)
+   Count Hierarchy::ForEachUnit(DMeta meta, F&& call) {
+      Count visited = 0;
+      bool done = false;
+      for (auto owner : *this) {
+         visited += owner->template ForEachUnit<SEEK>(meta, [&](A::Unit* unit) {
+            done = not Visit(call, unit);
+            return not done;
+         });
+
+         if (done)
+            break;
+      }
+      return visited;
+   }
+
+   /// Visit all traits of the given type inside the hierarchy, without       
+   /// collecting them in any intermediate container                          
+   ///   @tparam SEEK - where in the hierarchy are we seeking in?             
+   ///   @param trait - the trait to seek for                                 
+   ///   @param call - the visitor, may return void, bool or LoopControl      
+   ///   @return the number of visited traits                                 
+   template<Seek SEEK, class F> LANGULUS(INLINED)
+   Count Hierarchy::ForEachTrait(TMeta trait, F&& call) {
+      Count visited = 0;
+      bool done = false;
+      for (auto owner : *this) {
+         visited += owner->template ForEachTrait<SEEK>(trait, [&](const Trait& found) {
+            done = not Visit(call, found);
+            return not done;
+         });
+
+         if (done)
+            break;
+      }
+      return visited;
+   }
+
 } // namespace Langulus::Entity
\ No newline at end of file
@@ -257,6 +257,11 @@ namespace Langulus::Entity
 
       template<CT::Data D, Seek = Seek::HereAndAbove> NOD()
       auto GatherValues() const -> TMany<D>;
+
+      template<Seek = Seek::HereAndAbove, class F>
+      auto ForEachUnit(DMeta, F&&) -> Count;
+      template<Seek = Seek::HereAndAbove, class F>
+      auto ForEachTrait(TMeta, F&&) -> Count;
    };
 
 } // namespace Langulus::Entity
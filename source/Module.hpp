@@ -94,9 +94,23 @@ namespace Langulus::A
          DMeta mCategory;
       };
 
+      /// Update dependencies of a module. Exported through a separate,       
+      /// optional entry point, so that Info keeps its layout, and modules    
+      /// built before dependencies existed still load                        
+      struct Dependencies {
+         // Comma-separated names of modules, that must be updated      
+         // before this one. If nullptr, the module is ordered only by  
+         // priority, relative to other modules that don't declare any  
+         const char* mDependencies {};
+         // Comma-separated names of modules, that must never be        
+         // updated concurrently with this one                          
+         const char* mConflicts {};
+      };
+
       using EntryFunction  = void(*)(DMeta&, MetaList&);
       using CreateFunction = Module*(*)(Runtime*, const Many&);
       using InfoFunction   = const Info*(*)();
+      using DependenciesFunction = const Dependencies*(*)();
 
       NOD() auto GetRuntime() const noexcept -> Runtime* {
          return mRuntime;
@@ -131,6 +145,9 @@ namespace Langulus::CT
 /// Name of module information function                                       
 #define LANGULUS_MODULE_INFO()            LangulusModuleInfoPoint
 #define LANGULUS_MODULE_INFO_TOKEN()      LANGULUS_STRINGIFY(LANGULUS_MODULE_INFO())
+/// Name of the optional module dependencies function                         
+#define LANGULUS_MODULE_DEPENDENCIES()       LangulusModuleDependenciesPoint
+#define LANGULUS_MODULE_DEPENDENCIES_TOKEN() LANGULUS_STRINGIFY(LANGULUS_MODULE_DEPENDENCIES())
 
 
 /// Convenience macro for implementing module entry and exit points           
@@ -172,3 +189,27 @@ namespace Langulus::CT
          return &i; \
       } \
    }
+
+/// Convenience macro for implementing module entry and exit points, for      
+/// modules that declare their update dependencies. Modules that have no      
+/// dependency or conflict between them are updated concurrently              
+///   @param m - the type of the module interface, must inherit Module        
+///   @param prio - the priority of the module                                
+///   @param name - the module identifier token                               
+///   @param info - information string literal about the module               
+///   @param depo - relative path for the module, under Data/Modules/         
+///   @param cat - module category, i.e. some abstract type                   
+///   @param deps - comma-separated names of modules to update before this    
+///   @param conflicts - comma-separated names of modules, that shall never   
+///      be updated concurrently with this one                                
+///   @param ... - a type list to reflect upon module load                    
+#define LANGULUS_DEFINE_MODULE_DEPENDENT(m, prio, name, info, depo, cat, deps, conflicts, ...) \
+   LANGULUS_DEFINE_MODULE(m, prio, name, info, depo, cat, __VA_ARGS__) \
+   \
+   extern "C" { \
+      LANGULUS_EXPORT() \
+      const ::Langulus::A::Module::Dependencies* LANGULUS_MODULE_DEPENDENCIES() () { \
+         static const ::Langulus::A::Module::Dependencies d {deps, conflicts}; \
+         return &d; \
+      } \
+   }
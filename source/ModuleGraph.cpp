@@ -0,0 +1,238 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "ModuleGraph.hpp"
+
+
+namespace Langulus::Entity
+{
+   namespace
+   {
+
+      /// Invoke a callback for each name in a comma-separated list           
+      ///   @param list - the list of names, can be nullptr                   
+      ///   @param call - the function to call for each name                  
+      template<class F>
+      void ForEachModuleName(const char* list, F&& call) {
+         if (not list)
+            return;
+
+         const char* it = list;
+         while (*it) {
+            // Skip separators and whitespace                           
+            while (*it == ',' or *it == ' ' or *it == '\t')
+               ++it;
+
+            const char* start = it;
+            while (*it and *it != ',')
+               ++it;
+
+            // Trim trailing whitespace                                 
+            const char* end = it;
+            while (end > start and (end[-1] == ' ' or end[-1] == '\t'))
+               --end;
+
+            if (end > start)
+               call(Token {start, static_cast<Count>(end - start)});
+         }
+      }
+
+   } // namespace Langulus::Entity::<anonymous>
+
+   /// Build the graph from a list of modules                                 
+   ///   @param entries - the modules, sorted by priority, then by order of   
+   ///      instantiation                                                     
+   void ModuleGraph::Build(const ::std::vector<Entry>& entries) {
+      Clear();
+
+      const auto count = entries.size();
+      if (not count)
+         return;
+
+      // Check if a module's name matches a token                       
+      const auto named = [&](Offset i, const Token& name) {
+         const auto info = entries[i].mInfo;
+         return info and info->mName and Token {info->mName} == name;
+      };
+
+      // Collect edges in an adjacency matrix - module count is small   
+      using Matrix = ::std::vector<::std::vector<bool>>;
+      Matrix edges (count, ::std::vector<bool>(count));
+      for (Offset i = 0; i < count; ++i) {
+         if (not entries[i].mDependencies)
+            continue;
+
+         ForEachModuleName(entries[i].mDependencies->mDependencies, [&](const Token& dep) {
+            for (Offset j = 0; j < count; ++j) {
+               if (j != i and named(j, dep))
+                  edges[j][i] = true;
+            }
+         });
+      }
+
+      // Track which modules are reachable from which, so that edges    
+      // added below never contradict a transitive dependency path      
+      Matrix reach = edges;
+      for (Offset k = 0; k < count; ++k) {
+         for (Offset i = 0; i < count; ++i) {
+            if (not reach[i][k])
+               continue;
+            for (Offset j = 0; j < count; ++j) {
+               if (reach[k][j])
+                  reach[i][j] = true;
+            }
+         }
+      }
+
+      // Add an edge, and everything it makes reachable                 
+      const auto connect = [&](Offset from, Offset to) {
+         edges[from][to] = true;
+         for (Offset i = 0; i < count; ++i) {
+            if (i != from and not reach[i][from])
+               continue;
+            for (Offset j = 0; j < count; ++j) {
+               if (j == to or reach[to][j])
+                  reach[i][j] = true;
+            }
+         }
+      };
+
+      // Conflicting modules are serialized by priority, then by        
+      // instantiation order, unless dependencies already order them    
+      for (Offset i = 0; i < count; ++i) {
+         if (not entries[i].mDependencies)
+            continue;
+
+         ForEachModuleName(entries[i].mDependencies->mConflicts, [&](const Token& con) {
+            for (Offset j = 0; j < count; ++j) {
+               if (j == i or not named(j, con) or reach[i][j] or reach[j][i])
+                  continue;
+
+               if (j < i) connect(j, i);
+               else       connect(i, j);
+            }
+         });
+      }
+
+      // Modules without declared dependencies update strictly after    
+      // those of them with lower priority, just like before            
+      const auto legacy = [&](Offset i) {
+         return not entries[i].mDependencies
+             or not entries[i].mDependencies->mDependencies;
+      };
+
+      for (Offset i = 0; i < count; ++i) {
+         if (not legacy(i))
+            continue;
+
+         for (Offset j = i + 1; j < count; ++j) {
+            if (legacy(j) and entries[i].mPriority < entries[j].mPriority
+            and not reach[i][j] and not reach[j][i])
+               connect(i, j);
+         }
+      }
+
+      // Sort topologically using Kahn's algorithm, preferring priority 
+      // order among ready modules, so that sequential updates are      
+      // deterministic                                                  
+      ::std::vector<Count> incoming (count);
+      for (Offset i = 0; i < count; ++i) {
+         for (Offset j = 0; j < count; ++j)
+            incoming[j] += edges[i][j];
+      }
+
+      ::std::vector<Offset> order;
+      ::std::vector<bool> done (count);
+      order.reserve(count);
+      while (order.size() < count) {
+         Offset next = count;
+         for (Offset i = 0; i < count; ++i) {
+            if (not done[i] and not incoming[i]) {
+               next = i;
+               break;
+            }
+         }
+
+         if (next == count)
+            break;
+
+         done[next] = true;
+         order.push_back(next);
+         for (Offset j = 0; j < count; ++j)
+            incoming[j] -= edges[next][j];
+      }
+
+      if (order.size() < count) {
+         // There's a cycle in declared dependencies, so fall back to   
+         // sequential updates in priority order                        
+         Logger::Error("Module dependencies are cyclic - "
+            "modules will be updated sequentially by priority");
+
+         mCyclic = true;
+         order.resize(count);
+         for (Offset i = 0; i < count; ++i) {
+            order[i] = i;
+            for (Offset j = 0; j < count; ++j)
+               edges[i][j] = j == i + 1;
+         }
+      }
+
+      // Build the graph in topological order                           
+      ::std::vector<Offset> position (count);
+      for (Offset i = 0; i < count; ++i)
+         position[order[i]] = i;
+
+      mNodes.resize(count);
+      Count roots = 0;
+      for (Offset i = 0; i < count; ++i) {
+         auto& node = mNodes[i];
+         node.mModule = entries[order[i]].mModule;
+         node.mEntry = order[i];
+         for (Offset j = 0; j < count; ++j) {
+            if (edges[order[i]][j])
+               node.mSuccessors.push_back(position[j]);
+            if (edges[j][order[i]])
+               ++node.mPredecessors;
+         }
+
+         if (node.mSuccessors.size() > 1)
+            mConcurrent = true;
+         if (not node.mPredecessors)
+            ++roots;
+      }
+
+      if (roots > 1)
+         mConcurrent = true;
+   }
+
+   /// Remove all nodes                                                       
+   void ModuleGraph::Clear() noexcept {
+      mNodes.clear();
+      mConcurrent = false;
+      mCyclic = false;
+   }
+
+   /// Get the nodes of the graph                                             
+   ///   @return the nodes, in topological order                              
+   auto ModuleGraph::GetNodes() const noexcept -> const ::std::vector<Node>& {
+      return mNodes;
+   }
+
+   /// Check if any of the modules can update concurrently                    
+   ///   @return true if the graph has more than one path                     
+   bool ModuleGraph::IsConcurrent() const noexcept {
+      return mConcurrent;
+   }
+
+   /// Check if declared dependencies were cyclic, in which case modules      
+   /// update sequentially by priority                                        
+   ///   @return true if dependencies were cyclic                             
+   bool ModuleGraph::IsCyclic() const noexcept {
+      return mCyclic;
+   }
+
+} // namespace Langulus::Entity
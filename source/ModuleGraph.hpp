@@ -0,0 +1,75 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Module.hpp"
+#include <vector>
+
+
+namespace Langulus::Entity
+{
+
+   ///                                                                        
+   ///   Module update graph                                                  
+   ///                                                                        
+   ///   Orders module instances for updating. Modules that declare           
+   /// dependencies update after them, conflicting modules never update       
+   /// concurrently, and modules that declare no dependencies keep their      
+   /// priority order relative to each other. Nodes are kept in topological   
+   /// order, so walking them in sequence is a valid sequential update.       
+   ///   Cyclic dependencies fall back to a sequential chain in priority      
+   /// order. The graph is owned by a Runtime, and is rebuilt whenever        
+   /// modules are instantiated or destroyed.                                 
+   ///                                                                        
+   class ModuleGraph final {
+   public:
+      /// A module instance, as given when building the graph                 
+      struct Entry {
+         // The module instance                                         
+         A::Module* mModule {};
+         // The priority the module was registered with                 
+         Real mPriority {};
+         // The information of the module's library, can be nullptr     
+         const A::Module::Info* mInfo {};
+         // The update dependencies of the module's library, nullptr    
+         // if the library doesn't declare any                          
+         const A::Module::Dependencies* mDependencies {};
+      };
+
+      /// A node in the graph                                                 
+      struct Node {
+         // The module to update                                        
+         A::Module* mModule {};
+         // Index of the entry the node was made from                   
+         Offset mEntry {};
+         // Indices of nodes, that wait for this one to update          
+         ::std::vector<Offset> mSuccessors;
+         // Number of nodes, that have to update before this one        
+         Count mPredecessors {};
+      };
+
+   private:
+      // Nodes in topological order                                     
+      ::std::vector<Node> mNodes;
+      // Whether the graph allows any concurrent updates                
+      bool mConcurrent {};
+      // Whether declared dependencies were cyclic                      
+      bool mCyclic {};
+
+   public:
+      LANGULUS_API(ENTITY) void Build(const ::std::vector<Entry>&);
+      LANGULUS_API(ENTITY) void Clear() noexcept;
+
+      NOD() LANGULUS_API(ENTITY)
+      auto GetNodes() const noexcept -> const ::std::vector<Node>&;
+      NOD() LANGULUS_API(ENTITY)
+      bool IsConcurrent() const noexcept;
+      NOD() LANGULUS_API(ENTITY)
+      bool IsCyclic() const noexcept;
+   };
+
+} // namespace Langulus::Entity
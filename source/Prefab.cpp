@@ -0,0 +1,224 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Thing.hpp"
+#include "Thing.inl"
+#include <cmath>
+
+
+namespace Langulus::Entity
+{
+
+   /// Compile a creation descriptor                                          
+   ///   @param descriptor - the descriptor, as given to Verbs::Create        
+   Prefab::Prefab(const Many& descriptor)
+      : mDescriptor {descriptor} {
+      Compile(descriptor);
+      Measure();
+   }
+
+   /// Compile a part of the descriptor, mirroring Thing::CreateInner         
+   ///   @tparam T - type of instructions for creation                        
+   ///   @param stuff - creation instructions                                 
+   template<class T>
+   void Prefab::Compile(const T& stuff) {
+      if constexpr (CT::Deep<T> or CT::Neat<T>) {
+         // Nest if deep/neat                                           
+         stuff.ForEachDeep(
+            [this](const Trait& trait) {
+               Inspect(trait);
+               Instruction instruction {Kind::AddTrait};
+               instruction.mTrait = trait;
+               mProgram.emplace_back(::std::move(instruction));
+            },
+            [this](const Construct& construct) {
+               Compile(construct);
+            },
+            [this](const Neat& neat) {
+               Compile(neat);
+            },
+            [this](const DMeta& type) {
+               Compile(type);
+            }
+         );
+      }
+      else if constexpr (CT::Exact<T, DMeta>) {
+         // A type without any arguments is an uncharged construct      
+         Compile(Construct {stuff});
+      }
+      else if constexpr (CT::Construct<T>) {
+         const auto count = static_cast<int>(::std::ceil(stuff.GetCharge().mMass));
+         if (count <= 0)
+            return;
+
+         Instruction instruction {};
+         instruction.mCount = static_cast<Count>(count);
+         instruction.mType = stuff.GetType();
+
+         if (stuff.template Is<Thing>()) {
+            // Children are compiled in place, between BeginChild and   
+            // EndChild, and are executed in the new child              
+            instruction.mKind = Kind::BeginChild;
+            const auto begin = mProgram.size();
+            mProgram.emplace_back(::std::move(instruction));
+            Compile(stuff.GetDescriptor());
+            mProgram[begin].mEnd = mProgram.size();
+            mProgram.emplace_back(Instruction {Kind::EndChild});
+            return;
+         }
+         else if (stuff.template Is<Runtime>())
+            instruction.mKind = Kind::CreateRuntime;
+         else if (stuff.template Is<Temporal>())
+            instruction.mKind = Kind::CreateFlow;
+         else {
+            // Modules and any other data keep their construct, with    
+            // the producer resolved in advance                         
+            instruction.mKind = stuff.template CastsTo<A::Module>()
+               ? Kind::InstantiateModule : Kind::CreateData;
+            instruction.mConstruct = stuff;
+            if (instruction.mKind == Kind::CreateData) {
+               const auto type = instruction.mType;
+               instruction.mProducer = type and type->mProducerRetriever
+                  ? type->mProducerRetriever() : nullptr;
+            }
+
+            stuff->ForEachDeep([this](const Trait& trait) {
+               Inspect(trait);
+            });
+         }
+
+         mProgram.emplace_back(::std::move(instruction));
+      }
+      else static_assert(false, "Unsupported descriptor");
+   }
+
+   /// Check if a trait in the descriptor refers to the hierarchy             
+   ///   @param trait - the trait to check                                    
+   void Prefab::Inspect(const Trait& trait) {
+      if (trait.template IsTrait<Traits::Parent>()
+      or  trait.template CastsTo<Thing>()
+      or  trait.template CastsTo<A::Unit>())
+         mReferencesHierarchy = true;
+   }
+
+   /// Count the children and units each scope of the program creates, so     
+   /// that Things can reserve their containers once, before executing it     
+   void Prefab::Measure() {
+      ::std::vector<Capacity*> scopes {&mCapacity};
+      for (auto& instruction : mProgram) {
+         auto& scope = *scopes.back();
+
+         switch (instruction.mKind) {
+         case Kind::BeginChild:
+            scope.mChildren += instruction.mCount;
+            scopes.push_back(&instruction.mCapacity);
+            break;
+         case Kind::EndChild:
+            scopes.pop_back();
+            break;
+         case Kind::CreateData:
+            if (instruction.mType
+            and instruction.mType->template CastsTo<A::Unit>())
+               scope.mUnits += instruction.mCount;
+            break;
+         default:
+            break;
+         }
+      }
+   }
+
+   /// Get the descriptor the prefab was compiled from                        
+   ///   @return the descriptor                                               
+   auto Prefab::GetDescriptor() const noexcept -> const Many& {
+      return mDescriptor;
+   }
+
+   /// Get the compiled instructions                                          
+   ///   @return the instructions                                             
+   auto Prefab::GetProgram() const noexcept -> const ::std::vector<Instruction>& {
+      return mProgram;
+   }
+
+   /// Get how much the Thing, that executes the prefab, grows                
+   ///   @return the number of children and units the prefab creates          
+   auto Prefab::GetCapacity() const noexcept -> const Capacity& {
+      return mCapacity;
+   }
+
+   /// Check if the prefab can be cached - descriptors, that refer to Things  
+   /// or units, can't, because the cache would keep them alive               
+   ///   @return true if prefab can be cached                                 
+   bool Prefab::IsCacheable() const noexcept {
+      return not mReferencesHierarchy;
+   }
+
+   /// Execute the prefab in a Thing                                          
+   ///   @param thing - the Thing to create stuff in                          
+   ///   @param verb - the creation verb to output to                         
+   void Prefab::Execute(Thing& thing, Verb& verb) const {
+      thing.Reserve(mCapacity.mChildren, mCapacity.mUnits);
+      Execute(thing, verb, 0, mProgram.size());
+   }
+
+   /// Execute a range of instructions in a Thing                             
+   ///   @param thing - the Thing to create stuff in                          
+   ///   @param verb - the creation verb to output to                         
+   ///   @param begin - the first instruction                                 
+   ///   @param end - the instruction after the last one                      
+   void Prefab::Execute(Thing& thing, Verb& verb, Offset begin, Offset end) const {
+      for (auto i = begin; i < end; ++i) {
+         const auto& instruction = mProgram[i];
+
+         switch (instruction.mKind) {
+         case Kind::AddTrait:
+            verb << thing.AddTrait(instruction.mTrait);
+            break;
+         case Kind::BeginChild:
+            // Only the children are output, not what's made inside     
+            for (Count n = 0; n < instruction.mCount; ++n) {
+               Ref<Thing> child;
+               child.New(&thing);
+               child->Reserve(
+                  instruction.mCapacity.mChildren,
+                  instruction.mCapacity.mUnits
+               );
+               Verbs::Create inner {};
+               Execute(*child, inner, i + 1, instruction.mEnd);
+               verb << Abandon(child);
+            }
+
+            i = instruction.mEnd;
+            break;
+         case Kind::EndChild:
+            break;
+         case Kind::CreateRuntime:
+            for (Count n = 0; n < instruction.mCount; ++n)
+               verb << thing.CreateRuntime();
+            break;
+         case Kind::CreateFlow:
+            for (Count n = 0; n < instruction.mCount; ++n)
+               verb << thing.CreateFlow();
+            break;
+         case Kind::InstantiateModule:
+            for (Count n = 0; n < instruction.mCount; ++n) {
+               auto runtime = thing.GetRuntime();
+               auto dependency = runtime->GetDependency(instruction.mType);
+               verb << runtime->InstantiateModule(
+                  dependency, instruction.mConstruct.GetDescriptor());
+            }
+            break;
+         case Kind::CreateData:
+            for (Count n = 0; n < instruction.mCount; ++n) {
+               verb << thing.ProduceData(
+                  instruction.mConstruct, instruction.mProducer);
+            }
+            break;
+         }
+      }
+   }
+
+} // namespace Langulus::Entity
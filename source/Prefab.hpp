@@ -0,0 +1,98 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Common.hpp"
+#include <vector>
+
+
+namespace Langulus::Entity
+{
+
+   class Thing;
+
+
+   ///                                                                        
+   ///   Prefab                                                               
+   ///                                                                        
+   ///   A creation descriptor, compiled once into a flat list of             
+   /// instructions. Walking the descriptor, resolving types and their        
+   /// producers, and classifying them as Things, runtimes, flows, modules    
+   /// or plain data is done only while compiling. Executing a prefab in a    
+   /// Thing replays the instructions directly, producing the same result     
+   /// as Verbs::Create with the original descriptor.                         
+   ///   Runtimes cache prefabs by descriptor hash - see Runtime::GetPrefab.  
+   ///   The number of children and units each Thing receives is counted      
+   /// while compiling, too, so that containers are reserved only once.       
+   ///                                                                        
+   class Prefab final {
+   public:
+      enum class Kind {
+         AddTrait, BeginChild, EndChild,
+         CreateRuntime, CreateFlow, InstantiateModule, CreateData
+      };
+
+      /// How much a Thing grows, when the instructions for it execute        
+      struct Capacity {
+         Count mChildren {};
+         Count mUnits {};
+      };
+
+      /// A single compiled instruction                                       
+      struct Instruction {
+         Kind mKind;
+         // Number of times to execute the instruction, from the charge 
+         Count mCount {1};
+         // For BeginChild - the index of the matching EndChild         
+         Offset mEnd {};
+         // For BeginChild - how much each new child grows              
+         Capacity mCapacity {};
+         // The resolved type to produce                                
+         DMeta mType;
+         // The resolved producer of mType, if any                      
+         DMeta mProducer;
+         // The trait to add                                            
+         Trait mTrait;
+         // The construct to produce, or the module descriptor          
+         Construct mConstruct;
+      };
+
+   private:
+      // The descriptor the prefab was compiled from                    
+      Many mDescriptor;
+      // Compiled instructions, children are nested between BeginChild  
+      // and EndChild instructions                                      
+      ::std::vector<Instruction> mProgram;
+      // How much the Thing, that executes the prefab, grows            
+      Capacity mCapacity {};
+      // Whether the descriptor refers to Things or units, in which     
+      // case caching it would keep them alive                          
+      bool mReferencesHierarchy {};
+
+      template<class T>
+      void Compile(const T&);
+      void Inspect(const Trait&);
+      void Measure();
+      void Execute(Thing&, Verb&, Offset, Offset) const;
+
+   public:
+      LANGULUS_API(ENTITY) Prefab(const Many&);
+
+      NOD() LANGULUS_API(ENTITY)
+      auto GetDescriptor() const noexcept -> const Many&;
+      NOD() LANGULUS_API(ENTITY)
+      auto GetProgram() const noexcept -> const ::std::vector<Instruction>&;
+      NOD() LANGULUS_API(ENTITY)
+      auto GetCapacity() const noexcept -> const Capacity&;
+      NOD() LANGULUS_API(ENTITY)
+      bool IsCacheable() const noexcept;
+
+      LANGULUS_API(ENTITY)
+      void Execute(Thing&, Verb&) const;
+   };
+
+} // namespace Langulus::Entity
@@ -0,0 +1,108 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Thing.hpp"
+#include "Thing.inl"
+#include <algorithm>
+
+
+namespace Langulus::Entity
+{
+
+   /// Create a query                                                         
+   ///   @param runtime - the runtime that owns the query                     
+   ///   @param types - the required unit types                               
+   Query::Query(Runtime* runtime, ::std::vector<DMeta>&& types)
+      : mRuntime {runtime}
+      , mTypes   {::std::move(types)} {}
+
+   /// Get the required unit types                                            
+   ///   @return the types                                                    
+   auto Query::GetTypes() const noexcept -> const ::std::vector<DMeta>& {
+      return mTypes;
+   }
+
+   /// Get the number of matching Things                                      
+   ///   @return the number of matches                                        
+   Count Query::GetCount() const noexcept {
+      return mOwners.size();
+   }
+
+   /// Get the matching Things                                                
+   ///   @return the Things, in no particular order                           
+   auto Query::GetOwners() const noexcept -> ::std::span<Thing* const> {
+      return mOwners;
+   }
+
+   /// Get the units of a match, one for each required type                   
+   ///   @param row - the index of the match                                  
+   ///   @return the units, in the order of the required types                
+   auto Query::GetUnits(Offset row) const noexcept -> ::std::span<A::Unit* const> {
+      LANGULUS_ASSUME(DevAssumes, row < mOwners.size(), "Index out of range");
+      return {mUnits.data() + row * mTypes.size(), mTypes.size()};
+   }
+
+   /// Check if a Thing matches the query                                     
+   ///   @param thing - the thing to check                                    
+   ///   @return true if thing is matched                                     
+   bool Query::Contains(const Thing* thing) const noexcept {
+      return mRows.contains(thing);
+   }
+
+   /// Match a Thing against the query, after its units have changed          
+   ///   @param thing - the thing to match                                    
+   ///   @return true if thing matches                                        
+   bool Query::Update(Thing* thing) {
+      const auto& units = thing->GetUnitsMap();
+      for (auto type : mTypes) {
+         const auto found = units.FindIt(type);
+         if (not found or not found.GetValue()) {
+            Remove(thing);
+            return false;
+         }
+      }
+
+      const auto stride = mTypes.size();
+      auto row = mRows.find(thing);
+      if (row == mRows.end()) {
+         row = mRows.emplace(thing, mOwners.size()).first;
+         mOwners.push_back(thing);
+         mUnits.resize(mUnits.size() + stride);
+      }
+
+      // Refresh the units, they might have changed even if the match   
+      // itself didn't                                                  
+      const auto first = mUnits.begin() + row->second * stride;
+      for (Offset i = 0; i < stride; ++i)
+         first[i] = units.FindIt(mTypes[i]).GetValue()[0];
+      return true;
+   }
+
+   /// Remove a Thing from the matches, by swapping the last match in place   
+   ///   @param thing - the thing to remove                                   
+   void Query::Remove(const Thing* thing) {
+      const auto found = mRows.find(thing);
+      if (found == mRows.end())
+         return;
+
+      const auto stride = mTypes.size();
+      const auto row = found->second;
+      const auto last = mOwners.size() - 1;
+      mRows.erase(found);
+
+      if (row != last) {
+         mOwners[row] = mOwners[last];
+         ::std::copy_n(mUnits.begin() + last * stride, stride,
+            mUnits.begin() + row * stride);
+         mRows[mOwners[row]] = row;
+      }
+
+      mOwners.pop_back();
+      mUnits.resize(last * stride);
+   }
+
+} // namespace Langulus::Entity
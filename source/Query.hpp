@@ -0,0 +1,92 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Unit.hpp"
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Langulus::Entity
+{
+
+   class Thing;
+   class Runtime;
+
+   template<CT::Unit...>
+   class TQuery;
+
+
+   ///                                                                        
+   ///   Query                                                                
+   ///                                                                        
+   ///   A set of unit types, along with all Things in a runtime, that have   
+   /// at least one unit of each of these types. Queries are owned by the     
+   /// Runtime, and their matches are maintained incrementally, whenever      
+   /// a Thing's units change, so iterating them doesn't walk the hierarchy.  
+   ///                                                                        
+   class Query final {
+      friend class Runtime;
+      template<CT::Unit...>
+      friend class TQuery;
+
+      // The runtime that owns the query                                
+      Runtime* mRuntime {};
+      // The required unit types                                        
+      ::std::vector<DMeta> mTypes;
+      // The matching Things                                            
+      ::std::vector<Thing*> mOwners;
+      // The first unit of each required type, for each matching Thing  
+      // Contains mTypes.size() units for each owner                    
+      ::std::vector<A::Unit*> mUnits;
+      // Index of each matching Thing in mOwners                        
+      ::std::unordered_map<const Thing*, Offset> mRows;
+
+      bool Update(Thing*);
+      void Remove(const Thing*);
+
+   public:
+      Query(Runtime*, ::std::vector<DMeta>&&);
+
+      NOD() LANGULUS_API(ENTITY)
+      auto GetTypes() const noexcept -> const ::std::vector<DMeta>&;
+      NOD() LANGULUS_API(ENTITY)
+      Count GetCount() const noexcept;
+      NOD() LANGULUS_API(ENTITY)
+      auto GetOwners() const noexcept -> ::std::span<Thing* const>;
+      NOD() LANGULUS_API(ENTITY)
+      auto GetUnits(Offset) const noexcept -> ::std::span<A::Unit* const>;
+      NOD() LANGULUS_API(ENTITY)
+      bool Contains(const Thing*) const noexcept;
+   };
+
+
+   ///                                                                        
+   ///   Statically typed query handle                                        
+   ///                                                                        
+   ///   Lightweight handle to a Query in a Runtime, that gives typed access  
+   /// to the matched units. Produced via Runtime::GetQuery<T...>()           
+   ///                                                                        
+   template<CT::Unit...T>
+   class TQuery {
+      static_assert(sizeof...(T) > 0, "Query requires at least one unit type");
+      Query* mQuery {};
+
+   public:
+      TQuery(Query*) noexcept;
+
+      NOD() Count GetCount() const noexcept;
+      NOD() auto GetQuery() const noexcept -> Query*;
+
+      template<class F>
+      Count ForEach(F&&) const;
+      template<class F>
+      void ForEachParallel(F&&, Count = 64) const;
+   };
+
+} // namespace Langulus::Entity
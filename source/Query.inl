@@ -0,0 +1,100 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Runtime.hpp"
+#include <algorithm>
+#include <utility>
+
+#define TEMPLATE()   template<CT::Unit...T>
+
+
+namespace Langulus::Entity
+{
+
+   /// Wrap a query                                                           
+   ///   @param query - the query to wrap                                     
+   TEMPLATE() LANGULUS(INLINED)
+   TQuery<T...>::TQuery(Query* query) noexcept
+      : mQuery {query} {
+      LANGULUS_ASSUME(DevAssumes, query, "Invalid query");
+   }
+
+   /// Get the number of matching Things                                      
+   ///   @return the number of matches                                        
+   TEMPLATE() LANGULUS(INLINED)
+   Count TQuery<T...>::GetCount() const noexcept {
+      return mQuery->GetCount();
+   }
+
+   /// Get the untyped query                                                  
+   ///   @return the query                                                    
+   TEMPLATE() LANGULUS(INLINED)
+   auto TQuery<T...>::GetQuery() const noexcept -> Query* {
+      return mQuery;
+   }
+
+   /// Visit all matches                                                      
+   ///   @param call - the visitor, receives Thing& followed by a reference   
+   ///      to a unit of each type, and may return void, bool or LoopControl  
+   ///   @return the number of visited matches                                
+   TEMPLATE() template<class F>
+   Count TQuery<T...>::ForEach(F&& call) const {
+      const auto owners = mQuery->GetOwners();
+      for (Offset row = 0; row < owners.size(); ++row) {
+         const auto units = mQuery->GetUnits(row);
+         const bool proceed = [&]<Offset...I>(::std::index_sequence<I...>) {
+            return Visit(call, *owners[row],
+               *dynamic_cast<Decay<T>*>(units[I])...);
+         }(::std::index_sequence_for<T...> {});
+
+         if (not proceed)
+            return row + 1;
+      }
+
+      return owners.size();
+   }
+
+   /// Visit all matches concurrently, in batches, using the runtime's        
+   /// scheduler. Returns only after all matches have been visited            
+   ///   @attention the visitor is invoked from multiple threads at once,     
+   ///      and the query must not change while it's being iterated           
+   ///   @param call - the visitor, receives Thing& followed by a reference   
+   ///      to a unit of each type                                            
+   ///   @param batch - number of matches to visit in a single task           
+   TEMPLATE() template<class F>
+   void TQuery<T...>::ForEachParallel(F&& call, Count batch) const {
+      const auto owners = mQuery->GetOwners();
+      if (not batch)
+         batch = 1;
+
+      if (owners.size() <= batch) {
+         ForEach(call);
+         return;
+      }
+
+      auto& scheduler = mQuery->mRuntime->GetScheduler();
+      Scheduler::Group group;
+      for (Offset start = 0; start < owners.size(); start += batch) {
+         const auto end = ::std::min(start + batch, owners.size());
+         scheduler.Submit(group, [this, &call, start, end] {
+            for (Offset row = start; row < end; ++row) {
+               const auto units = mQuery->GetUnits(row);
+               [&]<Offset...I>(::std::index_sequence<I...>) {
+                  call(*mQuery->GetOwners()[row],
+                     *dynamic_cast<Decay<T>*>(units[I])...);
+               }(::std::index_sequence_for<T...> {});
+            }
+         });
+      }
+
+      scheduler.Wait(group);
+   }
+
+} // namespace Langulus::Entity
+
+#undef TEMPLATE
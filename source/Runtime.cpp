@@ -7,6 +7,7 @@
 ///                                                                           
 #include "Thing.hpp"
 #include "Runtime.hpp"
+#include "Handle.inl"
 #include "../include/Langulus/Asset.hpp"
 #include "../include/Langulus/Graphics.hpp"
 #include "../include/Langulus/Image.hpp"
@@ -21,6 +22,7 @@
 #include "../include/Langulus/Life.hpp"
 #include "../include/Langulus/Network.hpp"
 #include "../include/Langulus/User.hpp"
+#include <algorithm>
 
 #if LANGULUS_OS(WINDOWS)
    #include <Windows.h>
@@ -57,6 +59,8 @@ namespace Langulus::Entity
 {
 
    TUnorderedMap<Token, Runtime::SharedLibrary> Runtime::mLibraries;
+   ::std::vector<Runtime*> Runtime::mRuntimes;
+   ::std::mutex Runtime::mRuntimesMutex;
 
    /// Close a shared library handle, unloading it                            
    ///   @param library - the library handle                                  
@@ -153,6 +157,11 @@ namespace Langulus::Entity
       (void)MetaDataOf<A::UserModule>();
       (void)MetaDataOf<A::User>();
 
+      {
+         ::std::scoped_lock lock {mRuntimesMutex};
+         mRuntimes.push_back(this);
+      }
+
       VERBOSE(this, ": Initialized");
    }
 
@@ -160,6 +169,22 @@ namespace Langulus::Entity
    Runtime::~Runtime() {
       VERBOSE(this, ": Shutting down...");
 
+      // Parked Things are destroyed first, while everything's in place 
+      mThingPool.reset();
+
+      {
+         ::std::scoped_lock lock {mRuntimesMutex};
+         mRuntimes.erase(::std::find(mRuntimes.begin(), mRuntimes.end(), this));
+      }
+
+      // Detach from the runtime hierarchy                              
+      Nest(nullptr);
+      {
+         ::std::unique_lock lock {mRegistryMutex};
+         for (auto nested : mNestedRuntimes)
+            nested->mParentRuntime = nullptr;
+      }
+
       // First-stage destruction: tear down any potential circular      
       // references                                                     
       for (auto list : mModules) {
@@ -223,25 +248,21 @@ namespace Langulus::Entity
    ///   @param module - the module instance to push                          
    ///   @param type - the type to unregister the module as                   
    void RegisterAllBases(TUnorderedMap<DMeta, ModuleList>& map, A::Module* module, DMeta type) {
-      VERBOSE("Registering `", type, '`');
-      auto found = map.FindIt(type);
-      if (found)
-         found.GetValue() << module;
-      else {
-         // We always prefer 'type' definition that is in the main      
-         // boundary, to avoid segfaults when unloading libraries from  
-         // mModulesByType - it is indexed by a DMeta                   
-         auto localDefinition = RTTI::GetMetaData(type->mToken, RTTI::MainBoundary);
-         if (localDefinition)
-            map.Insert(localDefinition, module);
-         else
-            map.Insert(type, module);
-      }
-
-      for (auto& base : type->mBases) {
-         if (base.mType->IsExact<Resolvable>())
-            break;
-         RegisterAllBases(map, module, base.mType);
+      for (auto base : GetBaseList<Resolvable>(type)) {
+         VERBOSE("Registering `", base, '`');
+         auto found = map.FindIt(base);
+         if (found)
+            found.GetValue() << module;
+         else {
+            // We always prefer 'type' definition that is in the main   
+            // boundary, to avoid segfaults when unloading libraries    
+            // from mModulesByType - it is indexed by a DMeta           
+            auto localDefinition = RTTI::GetMetaData(base->mToken, RTTI::MainBoundary);
+            if (localDefinition)
+               map.Insert(localDefinition, module);
+            else
+               map.Insert(base, module);
+         }
       }
    }
 
@@ -250,17 +271,15 @@ namespace Langulus::Entity
    ///   @param module - the module instance to push                          
    ///   @param type - the type to register the module as                     
    void UnregisterAllBases(TUnorderedMap<DMeta, ModuleList>& map, A::Module* module, DMeta type) {
-      for (auto& base : type->mBases) {
-         if (base.mType->IsExact<Resolvable>())
-            break;
-         UnregisterAllBases(map, module, base.mType);
-      }
+      const auto& bases = GetBaseList<Resolvable>(type);
+      for (auto base = bases.rbegin(); base != bases.rend(); ++base) {
+         const auto found = map.FindIt(*base);
+         if (not found)
+            continue;
 
-      const auto found = map.FindIt(type);
-      if (found) {
          auto& list = found.GetValue();
          if (list.Remove(module) and not list) {
-            VERBOSE("Unregistering `", type, '`');
+            VERBOSE("Unregistering `", *base, '`');
             map.RemoveIt(found);
             if (not map)
                map.Reset();
@@ -323,6 +342,7 @@ namespace Langulus::Entity
       }
 
       // Done, if reached                                               
+      mModuleGraphDirty = true;
       VERBOSE(this, ": Module `", info->mName,
          "` registered with priority ", info->mPriority);
       return module;
@@ -389,6 +409,8 @@ namespace Langulus::Entity
             GetProcAddress(dll, LANGULUS_MODULE_CREATE_TOKEN()));
          library.mInfo = reinterpret_cast<A::Module::InfoFunction>(
             GetProcAddress(dll, LANGULUS_MODULE_INFO_TOKEN()));
+         library.mDependencies = reinterpret_cast<A::Module::DependenciesFunction>(
+            GetProcAddress(dll, LANGULUS_MODULE_DEPENDENCIES_TOKEN()));
       #else
          library.mEntry = reinterpret_cast<A::Module::EntryFunction>(
             dlsym(dll, LANGULUS_MODULE_ENTRY_TOKEN()));
@@ -396,6 +418,8 @@ namespace Langulus::Entity
             dlsym(dll, LANGULUS_MODULE_CREATE_TOKEN()));
          library.mInfo = reinterpret_cast<A::Module::InfoFunction>(
             dlsym(dll, LANGULUS_MODULE_INFO_TOKEN()));
+         library.mDependencies = reinterpret_cast<A::Module::DependenciesFunction>(
+            dlsym(dll, LANGULUS_MODULE_DEPENDENCIES_TOKEN()));
       #endif   
 
       if (not library.mEntry) {
@@ -510,6 +534,7 @@ namespace Langulus::Entity
                UnregisterAllBases(mModulesByType, *mod, modType);
                delete *mod;
                mod = list.GetValue().RemoveIt(mod);
+               mModuleGraphDirty = true;
             }
          }
 
@@ -527,6 +552,22 @@ namespace Langulus::Entity
       const auto wasMarked = library.mMarkedForUnload;
       const auto boundary = library.mBoundary;
 
+      // Libraries are shared by all runtimes, and cached prefabs of    
+      // any of them might keep data of the library's types in use.     
+      // Resetting might destroy parked Things, so it is done outside   
+      // of the lock                                                    
+      ResetPrefabs();
+      ::std::vector<Runtime*> runtimes;
+      {
+         ::std::scoped_lock lock {mRuntimesMutex};
+         runtimes = mRuntimes;
+      }
+
+      for (auto runtime : runtimes) {
+         if (runtime != this)
+            runtime->ResetPrefabs();
+      }
+
       IF_LANGULUS_MANAGED_MEMORY(Allocator::CollectGarbage());
 
       #if LANGULUS_FEATURE(MANAGED_REFLECTION) and LANGULUS_FEATURE(MANAGED_MEMORY)
@@ -550,6 +591,10 @@ namespace Langulus::Entity
 
       // If reached, then the library has no known allocations, using   
       // its reflected types - now we can safely unregister these types 
+      // Cached base lists and conversions might refer to               
+      // these types, too                                               
+      ResetBaseLists();
+      ResetConversions();
       IF_LANGULUS_MANAGED_REFLECTION(RTTI::UnloadBoundary(boundary));
       Logger::Info(
          "Module `", boundary, "` unloaded ",
@@ -609,18 +654,738 @@ namespace Langulus::Entity
    }
 #endif
 
-   /// Update the runtime, by updating all module instantiations by order of  
-   /// their priority                                                         
+   /// Find the information of the library, that produced a module            
+   ///   @param module - the module instance                                  
+   ///   @return the module info, or nullptr if library wasn't found          
+   auto Runtime::GetModuleInfo(const A::Module* module) const noexcept -> const A::Module::Info* {
+      for (auto library : mLibraries) {
+         if (module->Is(library.mValue.mModuleType))
+            return library.mValue.mInfo();
+      }
+      return nullptr;
+   }
+
+   /// Find the update dependencies of the library, that produced a module    
+   ///   @param module - the module instance                                  
+   ///   @return the dependencies, or nullptr if library wasn't found, or     
+   ///      if it doesn't export any                                          
+   auto Runtime::GetModuleDependencies(const A::Module* module) const noexcept -> const A::Module::Dependencies* {
+      for (auto library : mLibraries) {
+         if (module->Is(library.mValue.mModuleType)) {
+            return library.mValue.mDependencies
+               ? library.mValue.mDependencies() : nullptr;
+         }
+      }
+      return nullptr;
+   }
+
+   /// Rebuild the module update graph - see ModuleGraph                      
+   void Runtime::RebuildModuleGraph() {
+      mModuleGraphDirty = false;
+
+      // Gather modules by priority, then by instantiation order        
+      ::std::vector<ModuleGraph::Entry> entries;
+      for (auto pair : mModules) {
+         for (auto module : pair.mValue)
+            entries.push_back({
+               module, pair.mKey,
+               GetModuleInfo(module), GetModuleDependencies(module)
+            });
+      }
+
+      mModuleGraph.Build(entries);
+   }
+
+   /// Update the runtime, by updating all module instantiations in order of  
+   /// their dependencies and priorities. If parallel updates are enabled,    
+   /// modules that don't depend on each other are updated concurrently       
    ///   @param dt - delta time between update calls                          
    ///   @return true if no exit was requested by any of the modules          
    bool Runtime::Update(Time dt) {
-      for (auto pair : mModules) {
+      // Changes since the previous update become available to modules  
+      if (mTrackChanges) {
+         ::std::scoped_lock lock {mChangeMutex};
+         mChangedLastFrame = Move(mChangedThings);
+         mChangedLastSlots.swap(mChangedSlots);
+         mChangedSlots.clear();
+      }
+
+      if (mModuleGraphDirty)
+         RebuildModuleGraph();
+
+      if (mParallelUpdate and mModuleGraph.IsConcurrent())
+         return UpdateModulesConcurrently(dt);
+
+      for (auto& node : mModuleGraph.GetNodes()) {
+         if (not node.mModule->Update(dt))
+            return false;
+      }
+      return true;
+   }
+
+   /// Update modules concurrently, by walking the module graph in the        
+   /// scheduler - a module is submitted as soon as all its predecessors are  
+   /// done. All modules are always updated, even if one requests an exit     
+   ///   @param dt - delta time between update calls                          
+   ///   @return true if no exit was requested by any of the modules          
+   bool Runtime::UpdateModulesConcurrently(Time dt) {
+      auto& scheduler = GetScheduler();
+      Scheduler::Group group;
+      ::std::atomic<bool> exitRequested {};
+
+      const auto& nodes = mModuleGraph.GetNodes();
+      const auto count = nodes.size();
+      const auto pending = ::std::make_unique<::std::atomic<Count>[]>(count);
+      for (Offset i = 0; i < count; ++i)
+         pending[i].store(nodes[i].mPredecessors, ::std::memory_order_relaxed);
+
+      ::std::function<void(Offset)> run = [&](Offset index) {
+         const auto& node = nodes[index];
+         if (not node.mModule->Update(dt))
+            exitRequested.store(true, ::std::memory_order_relaxed);
+
+         for (auto next : node.mSuccessors) {
+            if (pending[next].fetch_sub(1, ::std::memory_order_acq_rel) == 1)
+               scheduler.Submit(group, [&run, next] { run(next); });
+         }
+      };
+
+      for (Offset i = 0; i < count; ++i) {
+         if (not nodes[i].mPredecessors)
+            scheduler.Submit(group, [&run, i] { run(i); });
+      }
+
+      scheduler.Wait(group);
+      return not exitRequested.load(::std::memory_order_relaxed);
+   }
+
+   /// Enable or disable parallel updates of the hierarchy, that uses this    
+   /// runtime. When enabled, subtrees that own their runtime are updated as  
+   /// separate tasks in the scheduler, shared by all runtimes                
+   ///   @param enable - whether or not to update subtrees in parallel        
+   ///   @param workers - number of worker threads to spawn, if the shared    
+   ///      scheduler isn't created yet; zero picks it based on hardware      
+   void Runtime::SetParallelUpdate(bool enable, Count workers) {
+      mParallelUpdate = enable;
+      if (enable)
+         (void) Scheduler::GetShared(workers);
+   }
+
+   /// Check if hierarchies are allowed to update subtrees in parallel        
+   ///   @return true if parallel update is enabled                           
+   bool Runtime::IsParallelUpdate() const noexcept {
+      return mParallelUpdate;
+   }
+
+   /// Get the task scheduler, shared by all runtimes in the process          
+   ///   @return a reference to the scheduler                                 
+   auto Runtime::GetScheduler() -> Scheduler& {
+      return Scheduler::GetShared();
+   }
+
+   /// Nest this runtime inside another one, so that queries on the parent    
+   /// runtime also reach units that are registered in this one               
+   ///   @param parent - the runtime to nest in, or nullptr to detach         
+   void Runtime::Nest(Runtime* parent) {
+      if (mParentRuntime == parent)
+         return;
+
+      if (mParentRuntime) {
+         ::std::unique_lock lock {mParentRuntime->mRegistryMutex};
+         auto& siblings = mParentRuntime->mNestedRuntimes;
+         siblings.erase(::std::find(siblings.begin(), siblings.end(), this));
+      }
+
+      mParentRuntime = parent;
+      if (parent) {
+         ::std::unique_lock lock {parent->mRegistryMutex};
+         parent->mNestedRuntimes.push_back(this);
+      }
+   }
+
+   /// Register a unit in the unit registry                                   
+   ///   @param type - the type to register the unit as                       
+   ///   @param unit - the unit to register                                   
+   ///   @param owner - the Thing that owns the unit                          
+   void Runtime::RegisterUnit(DMeta type, A::Unit* unit, Thing* owner) {
+      const UnitEntry entry {unit, owner};
+      ::std::unique_lock lock {mRegistryMutex};
+      const auto found = mUnitsByType.FindIt(type);
+      if (found) {
+         mUnitSlots.Insert(UnitSlot {type, entry}, found.GetValue().GetCount());
+         found.GetValue() << entry;
+      }
+      else {
+         mUnitSlots.Insert(UnitSlot {type, entry}, 0);
+         mUnitsByType.Insert(type, entry);
+      }
+   }
+
+   /// Unregister a unit from the unit registry, in constant time - the last  
+   /// unit registered as the same type takes its place                       
+   ///   @param type - the type the unit was registered as                    
+   ///   @param unit - the unit to unregister                                 
+   ///   @param owner - the Thing that owns the unit                          
+   void Runtime::UnregisterUnit(DMeta type, A::Unit* unit, Thing* owner) {
+      ::std::unique_lock lock {mRegistryMutex};
+      const auto slot = mUnitSlots.FindIt(UnitSlot {type, {unit, owner}});
+      if (not slot)
+         return;
+
+      const auto index = slot.GetValue();
+      mUnitSlots.RemoveIt(slot);
+      if (not mUnitSlots)
+         mUnitSlots.Reset();
+
+      // Move the last registration in the gap                          
+      const auto found = mUnitsByType.FindIt(type);
+      auto& list = found.GetValue();
+      const auto last = list.GetCount() - 1;
+      if (index != last) {
+         mUnitSlots.FindIt(UnitSlot {type, list[last]}).GetValue() = index;
+         list.Swap(index, last);
+      }
+
+      list.RemoveIndex(last);
+      if (not list) {
+         mUnitsByType.RemoveIt(found);
+         if (not mUnitsByType)
+            mUnitsByType.Reset();
+      }
+   }
+
+   /// Get all units of a type, registered in this runtime, in no particular  
+   /// order. Units in nested runtimes aren't included                        
+   ///   @attention not guarded - use only from the thread, that updates the  
+   ///      Things of this runtime, or use ForEachRegisteredUnit              
+   ///   @param type - the type of units to get                               
+   ///   @return the registered units and their owners                        
+   auto Runtime::GetRegisteredUnits(DMeta type) const noexcept -> const TMany<UnitEntry>& {
+      const auto found = mUnitsByType.FindIt(type);
+      if (found)
+         return found.GetValue();
+
+      static const TMany<UnitEntry> emptyFallback {};
+      return emptyFallback;
+   }
+
+   /// Enable or disable the archetype storage. When enabled, all Things      
+   /// that have units registered in this runtime are grouped by the types    
+   /// of their units, and can be iterated in chunks via ForEachChunk         
+   ///   @param enable - whether or not to maintain archetypes                
+   void Runtime::SetArchetypes(bool enable) {
+      if (not enable) {
+         mArchetypes.reset();
+         return;
+      }
+
+      if (mArchetypes)
+         return;
+
+      mArchetypes = ::std::make_unique<Archetypes>();
+      for (auto pair : mUnitsByType) {
+         for (auto& entry : pair.mValue) {
+            if (not mArchetypes->GetArchetype(entry.mOwner))
+               mArchetypes->Update(entry.mOwner);
+         }
+      }
+   }
+
+   /// Check if archetype storage is enabled                                  
+   ///   @return true if archetypes are maintained                            
+   bool Runtime::IsUsingArchetypes() const noexcept {
+      return mArchetypes != nullptr;
+   }
+
+   /// Get the archetype storage                                              
+   ///   @return the archetypes, or nullptr if they're not enabled            
+   auto Runtime::GetArchetypes() const noexcept -> const Archetypes* {
+      return mArchetypes.get();
+   }
+
+   /// Get a query for Things, that have units of all the given types         
+   /// If a query with the same types already exists, it is reused. A new     
+   /// query is matched against all Things, that use this runtime             
+   ///   @param types - the required unit types, in the order they're         
+   ///      provided when iterating the query                                 
+   ///   @return the query                                                    
+   auto Runtime::AddQuery(::std::vector<DMeta> types) -> Query* {
+      LANGULUS_ASSERT(not types.empty(), Access,
+         "Query requires at least one unit type");
+
+      for (auto& query : mQueries) {
+         if (query->mTypes == types)
+            return query.get();
+      }
+
+      auto query = mQueries.emplace_back(
+         ::std::make_unique<Query>(this, ::std::move(types))).get();
+
+      // Only Things that have the first type can possibly match        
+      for (auto& entry : GetRegisteredUnits(query->mTypes.front()))
+         query->Update(entry.mOwner);
+      return query;
+   }
+
+   /// Instantiate all modules of another runtime in this one                 
+   /// Used when cloning a Thing, that owns its runtime                       
+   ///   @param other - the runtime to copy the set of modules from           
+   void Runtime::CloneModules(const Runtime& other) {
+      for (auto pair : other.mModules) {
          for (auto module : pair.mValue) {
-            if (not module->Update(dt))
-               return false;
+            const auto library = other.GetDependency(module->GetType());
+            if (library.IsValid())
+               (void) InstantiateModule(library);
          }
       }
-      return true;
+   }
+
+   /// Get the command buffer, creating it if not created yet                 
+   /// Use it to defer structural changes to the hierarchy, while it's being  
+   /// updated or iterated                                                    
+   ///   @return a reference to the command buffer                            
+   auto Runtime::GetCommands() -> CommandBuffer& {
+      if (not mCommands)
+         mCommands = ::std::make_unique<CommandBuffer>();
+      return *mCommands;
+   }
+
+   /// Apply all deferred structural changes                                  
+   ///   @return the number of applied commands                               
+   Count Runtime::FlushCommands() {
+      return mCommands ? mCommands->Flush() : 0;
+   }
+
+   /// Get a compiled creation descriptor, compiling and caching it, if it    
+   /// wasn't compiled yet. When the cache is full, the oldest prefabs are    
+   /// evicted, along with any Things parked for them                         
+   ///   @attention descriptors, that refer to Things or units, are compiled  
+   ///      every time, because the cache would keep them alive               
+   ///   @param descriptor - the creation descriptor                          
+   ///   @return the compiled descriptor                                      
+   auto Runtime::GetPrefab(const Many& descriptor) -> ::std::shared_ptr<const Prefab> {
+      const Offset hash = descriptor.GetHash().mHash;
+
+      {
+         ::std::shared_lock lock {mPrefabMutex};
+         const auto range = mPrefabs.equal_range(hash);
+         for (auto it = range.first; it != range.second; ++it) {
+            if (it->second->GetDescriptor() == descriptor)
+               return it->second;
+         }
+      }
+
+      // Compile outside the lock, another thread might have compiled   
+      // the same descriptor in the meantime, but that's harmless       
+      auto prefab = ::std::make_shared<const Prefab>(descriptor);
+      if (not prefab->IsCacheable())
+         return prefab;
+
+      // Evicted prefabs are kept alive until parked Things are gone    
+      ::std::vector<::std::shared_ptr<const Prefab>> evicted;
+      {
+         ::std::unique_lock lock {mPrefabMutex};
+         if (not mPrefabCapacity)
+            return prefab;
+
+         while (mPrefabs.size() >= mPrefabCapacity)
+            evicted.emplace_back(EvictPrefab());
+         mPrefabs.emplace(hash, prefab);
+         mPrefabOrder.emplace_back(hash, prefab.get());
+      }
+
+      if (mThingPool) {
+         for (auto& old : evicted)
+            mThingPool->Discard(old.get());
+      }
+
+      return prefab;
+   }
+
+   /// Remove the oldest prefab from the cache                                
+   ///   @attention assumes mPrefabMutex is locked, and cache isn't empty     
+   ///   @return the evicted prefab                                           
+   auto Runtime::EvictPrefab() -> ::std::shared_ptr<const Prefab> {
+      const auto [hash, oldest] = mPrefabOrder.front();
+      mPrefabOrder.pop_front();
+
+      const auto range = mPrefabs.equal_range(hash);
+      for (auto it = range.first; it != range.second; ++it) {
+         if (it->second.get() == oldest) {
+            auto prefab = ::std::move(it->second);
+            mPrefabs.erase(it);
+            return prefab;
+         }
+      }
+
+      LANGULUS_ASSUME(DevAssumes, false, "Prefab order out of sync");
+      return {};
+   }
+
+   /// Get the number of cached prefabs                                       
+   ///   @return the number of prefabs                                        
+   Count Runtime::GetPrefabCount() const {
+      ::std::shared_lock lock {mPrefabMutex};
+      return mPrefabs.size();
+   }
+
+   /// Discard all cached prefabs                                             
+   /// Parked Things are reused by prefab, so they're discarded, too          
+   void Runtime::ResetPrefabs() {
+      {
+         ::std::unique_lock lock {mPrefabMutex};
+         mPrefabs.clear();
+         mPrefabOrder.clear();
+      }
+
+      if (mThingPool)
+         mThingPool->Clear();
+   }
+
+   /// Change the maximum number of cached prefabs                            
+   /// Oldest prefabs above the new capacity are evicted right away           
+   ///   @param capacity - the new capacity, or zero to disable caching       
+   void Runtime::SetPrefabCapacity(Count capacity) {
+      ::std::vector<::std::shared_ptr<const Prefab>> evicted;
+      {
+         ::std::unique_lock lock {mPrefabMutex};
+         mPrefabCapacity = capacity;
+         while (mPrefabs.size() > capacity)
+            evicted.emplace_back(EvictPrefab());
+      }
+
+      if (mThingPool) {
+         for (auto& old : evicted)
+            mThingPool->Discard(old.get());
+      }
+   }
+
+   /// Get the maximum number of cached prefabs                               
+   ///   @return the capacity                                                 
+   Count Runtime::GetPrefabCapacity() const {
+      ::std::shared_lock lock {mPrefabMutex};
+      return mPrefabCapacity;
+   }
+
+   /// Enable recycling of Things, so that Thing::Recycle parks Things in a   
+   /// pool, instead of destroying them, and Thing::CreateChild reuses them   
+   ///   @param capacity - the maximum number of parked Things per prefab,    
+   ///      or zero to disable recycling and destroy all parked Things        
+   void Runtime::SetThingPool(Count capacity) {
+      if (not capacity) {
+         mThingPool.reset();
+         return;
+      }
+
+      if (mThingPool)
+         mThingPool->SetCapacity(capacity);
+      else
+         mThingPool = ::std::make_unique<ThingPool>(capacity);
+   }
+
+   /// Get the pool of recycled Things                                        
+   ///   @return the pool, or nullptr if recycling isn't enabled              
+   auto Runtime::GetThingPool() noexcept -> ThingPool* {
+      return mThingPool.get();
+   }
+
+   /// Get the pool of recycled Things (const)                                
+   ///   @return the pool, or nullptr if recycling isn't enabled              
+   auto Runtime::GetThingPool() const noexcept -> const ThingPool* {
+      return mThingPool.get();
+   }
+
+   /// Issue a handle to a Thing - use Thing::GetHandle instead, which        
+   /// issues it only once, and releases it when the Thing leaves             
+   ///   @param thing - the Thing to refer to                                 
+   ///   @return the handle                                                   
+   auto Runtime::IssueHandle(Thing* thing) -> ThingHandle {
+      return mThingHandles.Issue(thing);
+   }
+
+   /// Issue a handle to a unit - use A::Unit::GetHandle instead, which       
+   /// issues it only once, and releases it when the unit leaves              
+   ///   @param unit - the unit to refer to                                   
+   ///   @return the handle                                                   
+   auto Runtime::IssueHandle(A::Unit* unit) -> UnitHandle {
+      return mUnitHandles.Issue(unit);
+   }
+
+   /// Release a handle to a Thing, so that it no longer resolves             
+   ///   @param handle - the handle to release                                
+   void Runtime::ReleaseHandle(ThingHandle handle) {
+      mThingHandles.Release(handle);
+   }
+
+   /// Release a handle to a unit, so that it no longer resolves              
+   ///   @param handle - the handle to release                                
+   void Runtime::ReleaseHandle(UnitHandle handle) {
+      mUnitHandles.Release(handle);
+   }
+
+   /// Make a handle refer to a Thing, that was moved to another place        
+   ///   @param handle - the handle                                           
+   ///   @param thing - the new Thing                                         
+   void Runtime::RebindHandle(ThingHandle handle, Thing* thing) {
+      mThingHandles.Rebind(handle, thing);
+   }
+
+   /// Get the Thing a handle refers to, in O(1)                              
+   ///   @param handle - the handle                                           
+   ///   @return the Thing, or nullptr if the handle is stale or invalid      
+   auto Runtime::Resolve(ThingHandle handle) const -> Thing* {
+      return mThingHandles.Resolve(handle);
+   }
+
+   /// Get the unit a handle refers to, in O(1)                               
+   ///   @param handle - the handle                                           
+   ///   @return the unit, or nullptr if the handle is stale or invalid       
+   auto Runtime::Resolve(UnitHandle handle) const -> A::Unit* {
+      return mUnitHandles.Resolve(handle);
+   }
+
+   /// Get the number of handles to Things and units, that are in use         
+   ///   @return the number of handles                                        
+   Count Runtime::GetHandleCount() const {
+      return mThingHandles.GetCount() + mUnitHandles.GetCount();
+   }
+
+   /// Visit a Thing and all Things below it, that use the given runtime      
+   /// Things below a nested runtime use it instead, and are skipped          
+   ///   @param thing - the Thing to start from                               
+   ///   @param runtime - the runtime Things must use                         
+   ///   @param call - the function to call for each Thing                    
+   template<class F>
+   void ForEachThingIn(Thing* thing, const Runtime* runtime, F&& call) {
+      if (not thing or thing->GetRuntime() == nullptr
+      or  &*thing->GetRuntime() != runtime)
+         return;
+
+      call(thing);
+      for (auto child : thing->GetChildren())
+         ForEachThingIn(child, runtime, call);
+   }
+
+   /// Add an index on the values of a trait type. All Things, that already   
+   /// use this runtime, are indexed immediately, and then kept up to date    
+   /// as their traits change. If an index on the same type exists, it's      
+   /// reused, and upgraded to ordered if required                            
+   ///   @param trait - the trait type to index                               
+   ///   @param kind - hash indexes search by equal values only, ordered      
+   ///      ones can also search by a range of numeric values                 
+   ///   @return the index                                                    
+   auto Runtime::AddTraitIndex(TMeta trait, TraitIndex::Kind kind) -> TraitIndex* {
+      LANGULUS_ASSERT(trait, Access, "Can't index traits without a type");
+
+      auto slot = mTraitIndexes.begin();
+      while (slot != mTraitIndexes.end() and (*slot)->mTrait != trait)
+         ++slot;
+
+      if (slot != mTraitIndexes.end()) {
+         if ((*slot)->mKind == kind or kind == TraitIndex::Kind::Hash)
+            return slot->get();
+
+         // Rebuild the existing index as ordered                       
+         *slot = ::std::make_unique<TraitIndex>(trait, kind);
+      }
+      else slot = mTraitIndexes.insert(slot, ::std::make_unique<TraitIndex>(trait, kind));
+
+      const auto index = slot->get();
+      ForEachThingIn(mOwner, this, [&](Thing* thing) {
+         const auto found = thing->GetTraits().FindIt(trait);
+         if (found) {
+            for (auto& value : found.GetValue())
+               index->Insert(value, thing);
+         }
+      });
+      return index;
+   }
+
+   /// Get the index on the values of a trait type                            
+   ///   @param trait - the trait type                                        
+   ///   @return the index, or nullptr if trait type isn't indexed            
+   auto Runtime::GetTraitIndex(TMeta trait) const noexcept -> const TraitIndex* {
+      for (auto& index : mTraitIndexes) {
+         if (index->mTrait == trait)
+            return index.get();
+      }
+      return nullptr;
+   }
+
+   /// Index a trait of a Thing, if its type is indexed                       
+   ///   @param trait - the added trait                                       
+   ///   @param thing - the Thing the trait was added to                      
+   void Runtime::IndexTrait(const Trait& trait, Thing* thing) {
+      for (auto& index : mTraitIndexes) {
+         if (index->mTrait == trait.GetTrait())
+            index->Insert(trait, thing);
+      }
+   }
+
+   /// Remove a trait of a Thing from the index, if its type is indexed       
+   ///   @attention call this before the trait is changed or destroyed        
+   ///   @param trait - the trait being removed                               
+   ///   @param thing - the Thing the trait is removed from                   
+   void Runtime::UnindexTrait(const Trait& trait, Thing* thing) {
+      for (auto& index : mTraitIndexes) {
+         if (index->mTrait == trait.GetTrait())
+            index->Remove(trait, thing);
+      }
+   }
+
+   /// Find all Things in this runtime, that have a trait of the given type   
+   /// and value. Uses the index on the trait type, if any, otherwise all     
+   /// Things in the runtime are searched                                     
+   ///   @param trait - the trait type                                        
+   ///   @param value - the value to search for                               
+   ///   @return the Things, in no particular order                           
+   auto Runtime::FindByTrait(TMeta trait, const Many& value) const -> TMany<Thing*> {
+      if (const auto index = GetTraitIndex(trait))
+         return index->Find(value);
+
+      TMany<Thing*> result;
+      ForEachThingIn(mOwner, this, [&](Thing* thing) {
+         const auto found = thing->GetTraits().FindIt(trait);
+         if (not found)
+            return;
+
+         for (auto& candidate : found.GetValue()) {
+            if (static_cast<const Many&>(candidate) == value) {
+               result << thing;
+               break;
+            }
+         }
+      });
+      return Abandon(result);
+   }
+
+   /// Find all Things in this runtime, that have a trait of the given type,  
+   /// whose value is in the range [min; max]                                 
+   ///   @attention requires an ordered index on the trait type               
+   ///   @param trait - the trait type                                        
+   ///   @param min - the smallest value                                      
+   ///   @param max - the largest value                                       
+   ///   @return the Things, sorted by value                                  
+   auto Runtime::FindByTraitRange(TMeta trait, Real min, Real max) const -> TMany<Thing*> {
+      const auto index = GetTraitIndex(trait);
+      LANGULUS_ASSERT(index, Access,
+         "Range lookups require an ordered index on `", trait, '`');
+      return index->FindRange(min, max);
+   }
+
+   /// Add an observer, that is notified of all changes in Things, that use   
+   /// this runtime - units added and removed, traits added, removed and      
+   /// changed, children attached and detached                                
+   ///   @attention observers are invoked on the thread, that made the        
+   ///      change, and must not be added or removed while the hierarchy is   
+   ///      being updated in parallel                                         
+   ///   @param observer - the function to invoke for each change             
+   ///   @return a handle for removing the observer                           
+   Offset Runtime::AddObserver(Observer&& observer) {
+      mObservers.emplace_back(mNextObserver, ::std::move(observer));
+      return mNextObserver++;
+   }
+
+   /// Remove an observer                                                     
+   ///   @param handle - the handle, returned by AddObserver                  
+   void Runtime::RemoveObserver(Offset handle) {
+      ::std::erase_if(mObservers, [handle](const auto& observer) {
+         return observer.first == handle;
+      });
+   }
+
+   /// Report a change in a Thing to all observers, and remember the Thing    
+   /// as changed in the current update, if tracking changes                  
+   ///   @param change - the change                                           
+   void Runtime::NotifyChange(const Change& change) {
+      if (mTrackChanges) {
+         ::std::scoped_lock lock {mChangeMutex};
+         if (mChangedSlots.try_emplace(change.mThing, mChangedThings.GetCount()).second)
+            mChangedThings << change.mThing;
+      }
+
+      for (auto& observer : mObservers)
+         observer.second(change);
+   }
+
+   /// Enable or disable collecting the Things, that change in each update.   
+   /// Disabled by default, so that changes cost nothing, unless needed       
+   ///   @attention must not be toggled while the hierarchy is being updated  
+   ///      in parallel                                                       
+   ///   @param enable - whether or not to collect changed Things             
+   void Runtime::SetChangeTracking(bool enable) {
+      mTrackChanges = enable;
+      if (enable)
+         return;
+
+      ::std::scoped_lock lock {mChangeMutex};
+      mChangedThings.Reset();
+      mChangedSlots.clear();
+      mChangedLastFrame.Reset();
+      mChangedLastSlots.clear();
+   }
+
+   /// Check if changed Things are collected                                  
+   ///   @return true if change tracking is enabled                           
+   bool Runtime::IsTrackingChanges() const noexcept {
+      return mTrackChanges;
+   }
+
+   /// Get the Things, that changed during the previous update, so that       
+   /// systems can process changes in batch, instead of polling all Things    
+   /// Each Thing is listed once, in no particular order                      
+   ///   @attention always empty, unless change tracking is enabled           
+   ///   @return the changed Things                                           
+   auto Runtime::GetChangedThings() const noexcept -> const TMany<Thing*>& {
+      return mChangedLastFrame;
+   }
+
+   /// Forget a Thing, that no longer uses this runtime, so that it never     
+   /// dangles in the changed Things                                          
+   ///   @param thing - the thing to forget                                   
+   void Runtime::ForgetChanges(const Thing* thing) {
+      if (not mTrackChanges)
+         return;
+
+      // Swap the Thing with the last one in the list, and pop it       
+      const auto unlist = [thing](TMany<Thing*>& list, auto& slots) {
+         const auto found = slots.find(thing);
+         if (found == slots.end())
+            return;
+
+         const auto slot = found->second;
+         const auto last = list.GetCount() - 1;
+         slots.erase(found);
+         if (slot != last) {
+            list[slot] = list[last];
+            slots[list[slot]] = slot;
+         }
+         list.RemoveIndex(last);
+      };
+
+      ::std::scoped_lock lock {mChangeMutex};
+      unlist(mChangedThings, mChangedSlots);
+      unlist(mChangedLastFrame, mChangedLastSlots);
+   }
+
+   /// Notify the runtime, that the units of a Thing have changed, so that    
+   /// archetypes and queries are kept up to date                             
+   ///   @param thing - the thing whose units have changed                    
+   void Runtime::NotifyUnitsChanged(Thing* thing) {
+      if (mArchetypes)
+         mArchetypes->Update(thing);
+      for (auto& query : mQueries)
+         query->Update(thing);
+   }
+
+   /// Notify the runtime, that a Thing no longer uses it, so that it's       
+   /// removed from all archetypes and queries                                
+   ///   @param thing - the thing to remove                                   
+   void Runtime::NotifyUnitsRemoved(const Thing* thing) {
+      if (mArchetypes)
+         mArchetypes->Remove(thing);
+      for (auto& query : mQueries)
+         query->Remove(thing);
    }
 
    /// Stringify the runtime, for debugging purposes                          
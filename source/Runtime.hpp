@@ -7,12 +7,27 @@
 ///                                                                           
 #pragma once
 #include "Module.hpp"
+#include "ModuleGraph.hpp"
+#include "Scheduler.hpp"
+#include "Archetype.hpp"
+#include "Query.hpp"
+#include "CommandBuffer.hpp"
+#include "Prefab.hpp"
+#include "TraitIndex.hpp"
+#include "Change.hpp"
+#include "ThingPool.hpp"
+#include "Handle.hpp"
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 
 namespace Langulus::A
 {
    struct File;
    struct Folder;
+   struct Unit;
 }
 
 namespace Langulus::Entity
@@ -33,6 +48,41 @@ namespace Langulus::Entity
    /// children, modules, units, etc.                                         
    ///                                                                        
    class Runtime final {
+   public:
+      ///                                                                     
+      ///   An entry in the unit registry                                     
+      ///                                                                     
+      struct UnitEntry {
+         LANGULUS(POD) true;
+
+         // The registered unit                                         
+         A::Unit* mUnit;
+         // The Thing that owns the unit                                
+         Thing* mOwner;
+
+         NOD() bool operator == (const UnitEntry&) const noexcept = default;
+      };
+
+      using UnitRegistry = TUnorderedMap<DMeta, TMany<UnitEntry>>;
+
+      ///                                                                     
+      ///   A registration in the unit registry, used to find its slot        
+      ///                                                                     
+      struct UnitSlot {
+         LANGULUS(POD) true;
+
+         // The type the unit is registered as                          
+         DMeta mType;
+         // The registered unit and its owner                           
+         UnitEntry mEntry;
+
+         NOD() Hash GetHash() const noexcept {
+            return HashBytes(this, static_cast<int>(sizeof(UnitSlot)));
+         }
+
+         NOD() bool operator == (const UnitSlot&) const noexcept = default;
+      };
+
    protected:
       ///                                                                     
       ///   Library handle                                                    
@@ -48,6 +98,8 @@ namespace Langulus::Entity
          A::Module::CreateFunction mCreator {};
          // Information function, returning module description          
          A::Module::InfoFunction mInfo {};
+         // Optional function, returning module update dependencies     
+         A::Module::DependenciesFunction mDependencies {};
          // Type of the module instance                                 
          DMeta mModuleType {};
          // The RTTI::Boundary of the library                           
@@ -65,6 +117,7 @@ namespace Langulus::Entity
             , mEntry           {other->mEntry}
             , mCreator         {other->mCreator}
             , mInfo            {other->mInfo}
+            , mDependencies    {other->mDependencies}
             , mModuleType      {other->mModuleType}
             , mBoundary        {other->mBoundary}
             , mMarkedForUnload {other->mMarkedForUnload} {}
@@ -84,28 +137,99 @@ namespace Langulus::Entity
             return HashBytes(&mHandle, static_cast<int>(sizeof(mHandle)));
          }
       };
-      
+
       // The owner of the runtime                                       
       Thing* mOwner {};
       // Loaded shared libraries, indexed by filename                   
       // This is a static registry - all Runtimes use the same shared   
       // library objects, but manage their own module instantiations    
       static TUnorderedMap<Token, SharedLibrary> mLibraries;
+      // All live Runtimes - caches of each of them might refer to      
+      // types from the shared libraries above                          
+      static ::std::vector<Runtime*> mRuntimes;
+      static ::std::mutex mRuntimesMutex;
       // Instantiated modules, sorted by priority                       
       TOrderedMap<Real, ModuleList> mModules;
       // Instantiated modules, indexed by type                          
       TUnorderedMap<DMeta, ModuleList> mModulesByType;
+      // Whether hierarchies are allowed to update subtrees in parallel 
+      bool mParallelUpdate {};
+      // Module update graph                                            
+      ModuleGraph mModuleGraph;
+      // Whether the module graph has to be rebuilt before next update  
+      bool mModuleGraphDirty {};
+      // Units of all Things that use this runtime, indexed by all of   
+      // their reflected bases. Entries are POD, so they don't keep     
+      // units or Things alive                                          
+      UnitRegistry mUnitsByType;
+      // The index of each registration inside mUnitsByType, so that    
+      // units are unregistered without scanning                        
+      TUnorderedMap<UnitSlot, Offset> mUnitSlots;
+      // The runtime this one is nested in, if any                      
+      Runtime* mParentRuntime {};
+      // Runtimes nested in this one                                    
+      ::std::vector<Runtime*> mNestedRuntimes;
+      // Guards mUnitsByType, mUnitSlots and mNestedRuntimes, because   
+      // nested runtimes are changed by subtrees updated in parallel,   
+      // while registry walks from above may reach them                 
+      mutable ::std::shared_mutex mRegistryMutex;
+      // Optional archetype storage, groups Things by their unit types  
+      ::std::unique_ptr<Archetypes> mArchetypes;
+      // Queries, whose matches are maintained as units change          
+      ::std::vector<::std::unique_ptr<Query>> mQueries;
+      // Deferred structural changes, created on demand                 
+      ::std::unique_ptr<CommandBuffer> mCommands;
+      // Compiled creation descriptors, indexed by descriptor hash      
+      ::std::unordered_multimap<Offset, ::std::shared_ptr<const Prefab>> mPrefabs;
+      // Cached prefabs in the order they were compiled, oldest first   
+      ::std::deque<::std::pair<Offset, const Prefab*>> mPrefabOrder;
+      // Maximum number of cached prefabs, oldest ones are evicted      
+      Count mPrefabCapacity {DefaultPrefabCapacity};
+      // Guards mPrefabs, Things may be created from worker threads     
+      mutable ::std::shared_mutex mPrefabMutex;
+      // Indexes on trait values, maintained as traits change           
+      ::std::vector<::std::unique_ptr<TraitIndex>> mTraitIndexes;
+      // Observers of changes in Things, along with their handles       
+      ::std::vector<::std::pair<Offset, Observer>> mObservers;
+      // The handle of the next observer                                
+      Offset mNextObserver {1};
+      // Whether changed Things are collected for GetChangedThings      
+      bool mTrackChanges {};
+      // Things that changed since the start of the current update,     
+      // along with their index in that list                            
+      TMany<Thing*> mChangedThings;
+      ::std::unordered_map<const Thing*, Offset> mChangedSlots;
+      // Things that changed during the previous update,                
+      // along with their index in that list                            
+      TMany<Thing*> mChangedLastFrame;
+      ::std::unordered_map<const Thing*, Offset> mChangedLastSlots;
+      // Guards the changed Things, they may change from worker threads 
+      mutable ::std::mutex mChangeMutex;
+      // Optional pool of recycled Things, created on demand            
+      ::std::unique_ptr<ThingPool> mThingPool;
+      // Handles to Things and units, issued on demand                  
+      THandleTable<Thing> mThingHandles;
+      THandleTable<A::Unit> mUnitHandles;
 
    protected:
       NOD() LANGULUS_API(ENTITY)
       auto LoadSharedLibrary(const Token&) -> SharedLibrary;
       NOD() bool UnloadSharedLibrary(const SharedLibrary&);
+      NOD() auto GetModuleInfo(const A::Module*) const noexcept -> const A::Module::Info*;
+      NOD() auto GetModuleDependencies(const A::Module*) const noexcept -> const A::Module::Dependencies*;
+      void RebuildModuleGraph();
+      NOD() auto EvictPrefab() -> ::std::shared_ptr<const Prefab>;
+      bool UpdateModulesConcurrently(Time);
 
    public:
       LANGULUS_CONVERTS_TO(Text);
 
+      // Default maximum number of cached prefabs                       
+      static constexpr Count DefaultPrefabCapacity = 1024;
+
       Runtime() = delete;
-      Runtime(Runtime&&) noexcept = default;
+      Runtime(const Runtime&) = delete;
+      Runtime(Runtime&&) = delete;
 
       LANGULUS_API(ENTITY)  Runtime(Thing*) noexcept;
       LANGULUS_API(ENTITY) ~Runtime();
@@ -118,6 +242,9 @@ namespace Langulus::Entity
       NOD() LANGULUS_API(ENTITY)
       auto InstantiateModule(const SharedLibrary&, const Many& = {}) -> A::Module*;
 
+      LANGULUS_API(ENTITY)
+      void CloneModules(const Runtime&);
+
       NOD() LANGULUS_API(ENTITY)
       auto GetDependency(DMeta) const noexcept -> SharedLibrary;
 
@@ -149,6 +276,117 @@ namespace Langulus::Entity
       LANGULUS_API(ENTITY)
       bool Update(Time);
 
+      LANGULUS_API(ENTITY)
+      void SetParallelUpdate(bool, Count = 0);
+      NOD() LANGULUS_API(ENTITY)
+      bool IsParallelUpdate() const noexcept;
+      NOD() LANGULUS_API(ENTITY)
+      auto GetScheduler() -> Scheduler&;
+
+      LANGULUS_API(ENTITY)
+      void Nest(Runtime*);
+
+      LANGULUS_API(ENTITY)
+      void RegisterUnit(DMeta, A::Unit*, Thing*);
+      LANGULUS_API(ENTITY)
+      void UnregisterUnit(DMeta, A::Unit*, Thing*);
+      NOD() LANGULUS_API(ENTITY)
+      auto GetRegisteredUnits(DMeta) const noexcept -> const TMany<UnitEntry>&;
+      template<class F>
+      bool ForEachRegisteredUnit(DMeta, F&&) const;
+
+      LANGULUS_API(ENTITY)
+      void SetArchetypes(bool);
+      NOD() LANGULUS_API(ENTITY)
+      bool IsUsingArchetypes() const noexcept;
+      NOD() LANGULUS_API(ENTITY)
+      auto GetArchetypes() const noexcept -> const Archetypes*;
+      template<CT::Unit...T, class F>
+      Count ForEachChunk(F&&) const;
+
+      NOD() LANGULUS_API(ENTITY)
+      auto AddQuery(::std::vector<DMeta>) -> Query*;
+      template<CT::Unit...T> NOD()
+      auto GetQuery() -> TQuery<T...>;
+
+      NOD() LANGULUS_API(ENTITY)
+      auto GetCommands() -> CommandBuffer&;
+      LANGULUS_API(ENTITY)
+      Count FlushCommands();
+
+      NOD() LANGULUS_API(ENTITY)
+      auto GetPrefab(const Many&) -> ::std::shared_ptr<const Prefab>;
+      NOD() LANGULUS_API(ENTITY)
+      Count GetPrefabCount() const;
+      LANGULUS_API(ENTITY)
+      void ResetPrefabs();
+      LANGULUS_API(ENTITY)
+      void SetPrefabCapacity(Count);
+      NOD() LANGULUS_API(ENTITY)
+      Count GetPrefabCapacity() const;
+
+      LANGULUS_API(ENTITY)
+      void SetThingPool(Count);
+      NOD() LANGULUS_API(ENTITY)
+      auto GetThingPool() noexcept -> ThingPool*;
+      NOD() LANGULUS_API(ENTITY)
+      auto GetThingPool() const noexcept -> const ThingPool*;
+
+      NOD() LANGULUS_API(ENTITY)
+      auto IssueHandle(Thing*) -> ThingHandle;
+      NOD() LANGULUS_API(ENTITY)
+      auto IssueHandle(A::Unit*) -> UnitHandle;
+      LANGULUS_API(ENTITY)
+      void ReleaseHandle(ThingHandle);
+      LANGULUS_API(ENTITY)
+      void ReleaseHandle(UnitHandle);
+      LANGULUS_API(ENTITY)
+      void RebindHandle(ThingHandle, Thing*);
+      NOD() LANGULUS_API(ENTITY)
+      auto Resolve(ThingHandle) const -> Thing*;
+      NOD() LANGULUS_API(ENTITY)
+      auto Resolve(UnitHandle) const -> A::Unit*;
+      NOD() LANGULUS_API(ENTITY)
+      Count GetHandleCount() const;
+
+      LANGULUS_API(ENTITY)
+      auto AddTraitIndex(TMeta, TraitIndex::Kind = TraitIndex::Kind::Hash) -> TraitIndex*;
+      NOD() LANGULUS_API(ENTITY)
+      auto GetTraitIndex(TMeta) const noexcept -> const TraitIndex*;
+      LANGULUS_API(ENTITY)
+      void IndexTrait(const Trait&, Thing*);
+      LANGULUS_API(ENTITY)
+      void UnindexTrait(const Trait&, Thing*);
+      NOD() LANGULUS_API(ENTITY)
+      auto FindByTrait(TMeta, const Many&) const -> TMany<Thing*>;
+      NOD() LANGULUS_API(ENTITY)
+      auto FindByTraitRange(TMeta, Real, Real) const -> TMany<Thing*>;
+
+      template<CT::Trait T> NOD()
+      auto FindByTrait(const Many& value) const -> TMany<Thing*> {
+         return FindByTrait(MetaTraitOf<T>(), value);
+      }
+
+      NOD() LANGULUS_API(ENTITY)
+      Offset AddObserver(Observer&&);
+      LANGULUS_API(ENTITY)
+      void RemoveObserver(Offset);
+      LANGULUS_API(ENTITY)
+      void NotifyChange(const Change&);
+      LANGULUS_API(ENTITY)
+      void SetChangeTracking(bool);
+      NOD() LANGULUS_API(ENTITY)
+      bool IsTrackingChanges() const noexcept;
+      NOD() LANGULUS_API(ENTITY)
+      auto GetChangedThings() const noexcept -> const TMany<Thing*>&;
+      LANGULUS_API(ENTITY)
+      void ForgetChanges(const Thing*);
+
+      LANGULUS_API(ENTITY)
+      void NotifyUnitsChanged(Thing*);
+      LANGULUS_API(ENTITY)
+      void NotifyUnitsRemoved(const Thing*);
+
       NOD() LANGULUS_API(ENTITY)
       explicit operator Text() const;
    };
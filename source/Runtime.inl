@@ -0,0 +1,76 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Runtime.hpp"
+#include "Archetype.inl"
+#include "Query.inl"
+
+
+namespace Langulus::Entity
+{
+
+   /// Visit all registered units of the given type, in this runtime and in   
+   /// all runtimes nested in it. Each registry is read-locked while it's     
+   /// visited, so it is safe while nested runtimes are updated in parallel   
+   ///   @attention the visitor must not add or remove units in the runtime   
+   ///      being visited                                                     
+   ///   @param type - the type of units to visit                             
+   ///   @param call - the visitor, receives the unit and its owner, and may  
+   ///      return void, bool or LoopControl                                  
+   ///   @return false if the visitor requested to stop                       
+   template<class F>
+   bool Runtime::ForEachRegisteredUnit(DMeta type, F&& call) const {
+      ::std::vector<Runtime*> nestedRuntimes;
+      {
+         ::std::shared_lock lock {mRegistryMutex};
+         const auto found = mUnitsByType.FindIt(type);
+         if (found) {
+            for (auto& entry : found.GetValue()) {
+               if (not Visit(call, entry.mUnit, entry.mOwner))
+                  return false;
+            }
+         }
+
+         // Nested runtimes are visited without holding this lock       
+         nestedRuntimes = mNestedRuntimes;
+      }
+
+      for (auto nested : nestedRuntimes) {
+         if (not nested->ForEachRegisteredUnit(type, call))
+            return false;
+      }
+
+      return true;
+   }
+
+   /// Visit all archetype chunks, whose Things contain all the given unit    
+   /// types. Runtimes nested in this one aren't included                     
+   ///   @attention archetypes must be enabled via SetArchetypes              
+   ///   @tparam T... - the required unit types                               
+   ///   @param call - the visitor, receives a const ArchetypeChunk&, and     
+   ///      may return void, bool or LoopControl                              
+   ///   @return the number of visited chunks                                 
+   template<CT::Unit...T, class F>
+   Count Runtime::ForEachChunk(F&& call) const {
+      if (not mArchetypes)
+         return 0;
+
+      const ::std::vector<DMeta> required {MetaDataOf<Decay<T>>()...};
+      return mArchetypes->ForEachChunk(required, ::std::forward<F>(call));
+   }
+
+   /// Get a query for Things, that have units of all the given types         
+   /// Queries are created on first request, and are reused afterwards        
+   ///   @tparam T... - the required unit types                               
+   ///   @return a typed handle to the query                                  
+   template<CT::Unit...T> LANGULUS(INLINED)
+   auto Runtime::GetQuery() -> TQuery<T...> {
+      return AddQuery({MetaDataOf<Decay<T>>()...});
+   }
+
+} // namespace Langulus::Entity
@@ -0,0 +1,198 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Scheduler.hpp"
+
+
+namespace Langulus::Entity
+{
+
+   /// The scheduler the current thread works for, if any                     
+   thread_local const Scheduler* tScheduler {};
+   /// The worker index of the current thread inside tScheduler               
+   thread_local Offset tWorker {};
+
+   /// Scheduler construction, spawns worker threads                          
+   ///   @param workers - number of worker threads to spawn; if zero, the     
+   ///      number of hardware threads minus one is used, because the thread  
+   ///      that waits for a group always helps with execution                
+   Scheduler::Scheduler(Count workers) {
+      if (not workers) {
+         const auto hardware = ::std::thread::hardware_concurrency();
+         workers = hardware > 1 ? hardware - 1 : 1;
+      }
+
+      mWorkers.reserve(workers);
+      for (Offset i = 0; i < workers; ++i)
+         mWorkers.emplace_back(::std::make_unique<Worker>());
+
+      // Threads are started only after all queues are in place,        
+      // because workers are allowed to steal from each other           
+      for (Offset i = 0; i < workers; ++i)
+         mWorkers[i]->mThread = ::std::thread {&Scheduler::Work, this, i};
+   }
+
+   /// Scheduler destruction, joins all worker threads                        
+   ///   @attention any tasks that were not waited upon are discarded         
+   Scheduler::~Scheduler() {
+      {
+         ::std::scoped_lock lock {mSleepMutex};
+         mExit = true;
+      }
+      mWake.notify_all();
+
+      for (auto& worker : mWorkers) {
+         if (worker->mThread.joinable())
+            worker->mThread.join();
+      }
+   }
+
+   /// Get the scheduler, that is shared by all runtimes in the process       
+   /// It is created on first request, and destroyed on exit                  
+   ///   @param workers - number of worker threads to spawn, if the shared    
+   ///      scheduler isn't created yet; zero picks it based on hardware      
+   ///   @return a reference to the shared scheduler                          
+   auto Scheduler::GetShared(Count workers) -> Scheduler& {
+      static Scheduler shared {workers};
+      return shared;
+   }
+
+   /// Get the number of worker threads                                       
+   ///   @return the number of workers                                        
+   Count Scheduler::GetWorkerCount() const noexcept {
+      return mWorkers.size();
+   }
+
+   /// Submit a task for asynchronous execution                               
+   /// If called from a worker, the task goes to the worker's own queue,      
+   /// otherwise workers are picked in a round-robin fashion                  
+   ///   @param group - the group to account the task in                      
+   ///   @param task - the task to execute                                    
+   void Scheduler::Submit(Group& group, Task&& task) {
+      group.mPending.fetch_add(1, ::std::memory_order_relaxed);
+
+      // Account for the job before it becomes visible, so that the     
+      // counter never drops below zero when the job is popped early    
+      {
+         ::std::scoped_lock lock {mSleepMutex};
+         mQueued.fetch_add(1, ::std::memory_order_release);
+      }
+
+      const Offset target = tScheduler == this ? tWorker
+         : mNextWorker.fetch_add(1, ::std::memory_order_relaxed) % mWorkers.size();
+
+      {
+         auto& worker = *mWorkers[target];
+         ::std::scoped_lock lock {worker.mMutex};
+         worker.mQueue.push_back(Job {::std::move(task), &group});
+      }
+
+      mWake.notify_one();
+   }
+
+   /// Wait for all tasks in a group to finish, executing pending tasks       
+   /// in the meantime, instead of blocking                                   
+   ///   @attention rethrows the first exception that a task has thrown       
+   ///   @param group - the group to wait for                                 
+   void Scheduler::Wait(Group& group) {
+      const Offset home = tScheduler == this ? tWorker : 0;
+      while (group.mPending.load(::std::memory_order_acquire)) {
+         if (not TryExecute(home))
+            ::std::this_thread::yield();
+      }
+
+      if (group.mException) {
+         auto exception = group.mException;
+         group.mException = nullptr;
+         ::std::rethrow_exception(exception);
+      }
+   }
+
+   /// Worker thread routine                                                  
+   ///   @param index - the index of the worker                               
+   void Scheduler::Work(Offset index) {
+      tScheduler = this;
+      tWorker = index;
+
+      while (not mExit.load(::std::memory_order_acquire)) {
+         if (TryExecute(index))
+            continue;
+
+         // Nothing to do, so sleep until something is submitted        
+         // Jobs are accounted under mSleepMutex before notifying, so   
+         // a submission is never missed between the attempt and wait   
+         ::std::unique_lock lock {mSleepMutex};
+         mWake.wait(lock, [this] {
+            return mExit.load(::std::memory_order_acquire)
+                or mQueued.load(::std::memory_order_acquire) > 0;
+         });
+      }
+   }
+
+   /// Execute a single task, either from the local queue, or stolen from     
+   /// another worker's queue                                                 
+   ///   @param home - the queue to check first                               
+   ///   @return true if a task was executed                                  
+   bool Scheduler::TryExecute(Offset home) {
+      Job job;
+      if (not Pop(home, job) and not Steal(home, job))
+         return false;
+
+      mQueued.fetch_sub(1, ::std::memory_order_acq_rel);
+      Execute(job);
+      return true;
+   }
+
+   /// Pop the most recently pushed job from a queue (LIFO, cache-friendly)   
+   ///   @param index - the worker queue to pop from                          
+   ///   @param job - [out] the popped job                                    
+   ///   @return true if a job was popped                                     
+   bool Scheduler::Pop(Offset index, Job& job) {
+      auto& worker = *mWorkers[index];
+      ::std::scoped_lock lock {worker.mMutex};
+      if (worker.mQueue.empty())
+         return false;
+
+      job = ::std::move(worker.mQueue.back());
+      worker.mQueue.pop_back();
+      return true;
+   }
+
+   /// Steal the oldest job from any other queue (FIFO, coarse-grained)       
+   ///   @param thief - the index of the queue that is stealing               
+   ///   @param job - [out] the stolen job                                    
+   ///   @return true if a job was stolen                                     
+   bool Scheduler::Steal(Offset thief, Job& job) {
+      const auto count = mWorkers.size();
+      for (Offset i = 1; i <= count; ++i) {
+         auto& victim = *mWorkers[(thief + i) % count];
+         ::std::scoped_lock lock {victim.mMutex};
+         if (victim.mQueue.empty())
+            continue;
+
+         job = ::std::move(victim.mQueue.front());
+         victim.mQueue.pop_front();
+         return true;
+      }
+
+      return false;
+   }
+
+   /// Execute a job and account for it in its group                          
+   ///   @param job - the job to execute                                      
+   void Scheduler::Execute(Job& job) {
+      try { job.mTask(); }
+      catch (...) {
+         ::std::scoped_lock lock {job.mGroup->mExceptionMutex};
+         if (not job.mGroup->mException)
+            job.mGroup->mException = ::std::current_exception();
+      }
+
+      job.mGroup->mPending.fetch_sub(1, ::std::memory_order_acq_rel);
+   }
+
+} // namespace Langulus::Entity
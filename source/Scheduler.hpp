@@ -0,0 +1,108 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Common.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace Langulus::Entity
+{
+
+   ///                                                                        
+   ///   Work-stealing task scheduler                                         
+   ///                                                                        
+   ///   A small thread pool, shared by all runtimes in the process, that is  
+   /// used to update independent parts of a hierarchy concurrently. Sharing  
+   /// it keeps nested runtimes from oversubscribing the CPU with their own   
+   /// pools - see Scheduler::GetShared. Every worker has its                 
+   /// own task queue - it pushes and pops from the back of it, while idle    
+   /// workers steal from the front of other workers' queues.                 
+   ///   Threads that wait for a task group to finish help by executing       
+   /// pending tasks, so nested parallelism never deadlocks the pool.         
+   ///                                                                        
+   class Scheduler final {
+   public:
+      using Task = ::std::function<void()>;
+
+      ///                                                                     
+      ///   A group of tasks that can be waited upon                          
+      ///                                                                     
+      class Group {
+         friend class Scheduler;
+         // Number of submitted tasks that haven't finished yet         
+         ::std::atomic<Count> mPending {};
+         // First exception thrown by a task in the group, if any       
+         ::std::exception_ptr mException;
+         ::std::mutex mExceptionMutex;
+
+      public:
+         Group() = default;
+         Group(const Group&) = delete;
+         Group& operator = (const Group&) = delete;
+      };
+
+   private:
+      /// A task, along with the group it belongs to                          
+      struct Job {
+         Task   mTask;
+         Group* mGroup {};
+      };
+
+      /// A worker thread, along with its task queue                          
+      struct Worker {
+         ::std::mutex mMutex;
+         ::std::deque<Job> mQueue;
+         ::std::thread mThread;
+      };
+
+      // Worker threads                                                 
+      ::std::vector<::std::unique_ptr<Worker>> mWorkers;
+      // Number of jobs that are currently queued in all workers        
+      ::std::atomic<Count> mQueued {};
+      // Used for round-robin submission from non-worker threads        
+      ::std::atomic<Count> mNextWorker {};
+      // Signals workers to exit                                        
+      ::std::atomic<bool> mExit {};
+      // Used to put idle workers to sleep                              
+      ::std::mutex mSleepMutex;
+      ::std::condition_variable mWake;
+
+      void Work(Offset);
+      bool TryExecute(Offset);
+      bool Pop(Offset, Job&);
+      bool Steal(Offset, Job&);
+      static void Execute(Job&);
+
+   public:
+      LANGULUS_API(ENTITY)  Scheduler(Count = 0);
+      LANGULUS_API(ENTITY) ~Scheduler();
+
+      Scheduler(const Scheduler&) = delete;
+      Scheduler(Scheduler&&) = delete;
+      Scheduler& operator = (const Scheduler&) = delete;
+      Scheduler& operator = (Scheduler&&) = delete;
+
+      NOD() LANGULUS_API(ENTITY)
+      static auto GetShared(Count = 0) -> Scheduler&;
+
+      NOD() LANGULUS_API(ENTITY)
+      Count GetWorkerCount() const noexcept;
+
+      LANGULUS_API(ENTITY) void Submit(Group&, Task&&);
+      LANGULUS_API(ENTITY) void Wait(Group&);
+   };
+
+} // namespace Langulus::Entity
@@ -0,0 +1,142 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Common.hpp"
+#include <optional>
+#include <new>
+#include <type_traits>
+
+
+namespace Langulus::Entity
+{
+
+   ///                                                                        
+   ///   Small map                                                            
+   ///                                                                        
+   ///   A map from meta definitions (DMeta, TMeta...) to containers, that    
+   /// keeps up to N pairs inline, in a flat array sorted by key. Most Things 
+   /// have only a handful of units and traits, so a lookup is a short scan   
+   /// over a single cache line, instead of hashing and probing a heap        
+   /// allocated table. When the N+1th key is inserted, all pairs are moved   
+   /// to a TUnorderedMap, which is used until the map becomes empty again.   
+   ///   The inline pairs and the overflow map share the same storage, so     
+   /// the small map allocates nothing until it overflows. N has no default - 
+   /// pick it for the expected number of keys, because the inline pairs      
+   /// include the values, and as many of them as fit in a TUnorderedMap are  
+   /// usually just one or two.                                               
+   ///                                                                        
+   template<class K, class V, Count N>
+   class TSmallMap {
+      static_assert(N > 0, "Small map requires at least one inline slot");
+
+   public:
+      using Map = TUnorderedMap<K, V>;
+
+      /// A key and a reference to its value, produced when iterating         
+      template<bool MUTABLE>
+      struct Pair {
+         const K& mKey;
+         ::std::conditional_t<MUTABLE, V&, const V&> mValue;
+      };
+
+      /// Marks the end of iteration                                          
+      struct IteratorEnd {};
+
+      ///                                                                     
+      ///   Iterator, that works both for inline and overflown pairs          
+      ///                                                                     
+      template<bool MUTABLE>
+      class Iterator {
+         friend class TSmallMap;
+         using Owner = ::std::conditional_t<MUTABLE, TSmallMap, const TSmallMap>;
+         using MapIterator = decltype(::std::declval<
+            ::std::conditional_t<MUTABLE, Map&, const Map&>>().begin());
+         using Reference = ::std::conditional_t<MUTABLE, V&, const V&>;
+
+         // The map that is iterated                                    
+         Owner* mOwner {};
+         // The inline pair, if map hasn't overflown                     
+         Offset mIndex {};
+         // The pair in the overflow map, if map has overflown          
+         ::std::optional<MapIterator> mMapIterator;
+
+         Iterator(Owner*, Offset) noexcept;
+         Iterator(Owner*, MapIterator&&) noexcept;
+
+      public:
+         NOD() explicit operator bool() const noexcept;
+         NOD() bool operator == (IteratorEnd) const noexcept;
+
+         NOD() auto GetKey() const noexcept -> const K&;
+         NOD() auto GetValue() const noexcept -> Reference;
+         NOD() auto operator * () const noexcept -> Pair<MUTABLE>;
+         auto operator ++ () noexcept -> Iterator&;
+      };
+
+   protected:
+      /// Inline pairs, used until the map overflows                          
+      struct Inline {
+         // Inline keys, sorted                                         
+         K mKeys[N] {};
+         // Inline values, one for each inline key                      
+         V mValues[N] {};
+      };
+
+      // Number of pairs in the inline arrays                           
+      Count mInlineCount {};
+      // Whether pairs are in the overflow map, instead of inline       
+      bool mOverflown {};
+      union {
+         // Inline pairs, active while not overflown                    
+         Inline mInline;
+         // Overflow map, active while overflown                        
+         Map mMap;
+      };
+
+      NOD() static uintptr_t Order(const K&) noexcept;
+      NOD() Offset LowerBound(const K&) const noexcept;
+      void Overflow();
+      void Underflow() noexcept;
+
+   public:
+      TSmallMap() noexcept;
+      TSmallMap(const TSmallMap&);
+      TSmallMap(TSmallMap&&) noexcept;
+      ~TSmallMap();
+
+      TSmallMap& operator = (const TSmallMap&);
+      TSmallMap& operator = (TSmallMap&&) noexcept;
+
+      NOD() Count GetCount() const noexcept;
+      NOD() bool IsEmpty() const noexcept;
+      NOD() bool IsOverflown() const noexcept;
+      NOD() explicit operator bool() const noexcept;
+      NOD() bool operator == (const TSmallMap&) const;
+
+      NOD() auto FindIt(const K&)       -> Iterator<true>;
+      NOD() auto FindIt(const K&) const -> Iterator<false>;
+
+      NOD() auto operator[] (const K&)       ->       V&;
+      NOD() auto operator[] (const K&) const -> const V&;
+
+      template<class T>
+      auto Insert(const K&, T&&) -> V&;
+      template<class KEYS, class T>
+      void Append(const KEYS&, const T&);
+      void RemoveIt(const Iterator<true>&);
+      void Reset();
+
+      template<class F>
+      Count ForEachValue(F&&);
+
+      NOD() auto begin()       -> Iterator<true>;
+      NOD() auto begin() const -> Iterator<false>;
+      NOD() constexpr IteratorEnd end() const noexcept { return {}; }
+   };
+
+} // namespace Langulus::Entity
@@ -0,0 +1,466 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "SmallMap.hpp"
+
+#define TEMPLATE()   template<class K, class V, Count N>
+#define MAP()        TSmallMap<K, V, N>
+
+
+namespace Langulus::Entity
+{
+
+   /// Default construction, with no pairs and no allocations                 
+   TEMPLATE() LANGULUS(INLINED)
+   MAP()::TSmallMap() noexcept
+      : mInline {} {}
+
+   /// Copy construction                                                      
+   ///   @param other - the map to copy                                       
+   TEMPLATE() LANGULUS(INLINED)
+   MAP()::TSmallMap(const TSmallMap& other)
+      : TSmallMap {} {
+      *this = other;
+   }
+
+   /// Move construction                                                      
+   ///   @param other - the map to move, left empty afterwards                
+   TEMPLATE() LANGULUS(INLINED)
+   MAP()::TSmallMap(TSmallMap&& other) noexcept
+      : TSmallMap {} {
+      *this = ::std::move(other);
+   }
+
+   /// Destruction, destroys whichever storage is active                      
+   TEMPLATE() LANGULUS(INLINED)
+   MAP()::~TSmallMap() {
+      if (mOverflown)
+         mMap.~Map();
+      else
+         mInline.~Inline();
+   }
+
+   /// Copy assignment                                                        
+   ///   @param other - the map to copy                                       
+   ///   @return a reference to this map                                      
+   TEMPLATE()
+   auto MAP()::operator = (const TSmallMap& other) -> TSmallMap& {
+      if (&other == this)
+         return *this;
+
+      Reset();
+      if (other.mOverflown) {
+         mInline.~Inline();
+         new (&mMap) Map {other.mMap};
+         mOverflown = true;
+         return *this;
+      }
+
+      for (Offset i = 0; i < other.mInlineCount; ++i) {
+         mInline.mKeys[i] = other.mInline.mKeys[i];
+         mInline.mValues[i] = other.mInline.mValues[i];
+      }
+
+      mInlineCount = other.mInlineCount;
+      return *this;
+   }
+
+   /// Move assignment                                                        
+   ///   @param other - the map to move, left empty afterwards                
+   ///   @return a reference to this map                                      
+   TEMPLATE()
+   auto MAP()::operator = (TSmallMap&& other) noexcept -> TSmallMap& {
+      if (&other == this)
+         return *this;
+
+      Reset();
+      if (other.mOverflown) {
+         mInline.~Inline();
+         new (&mMap) Map {::std::move(other.mMap)};
+         mOverflown = true;
+         other.Reset();
+         return *this;
+      }
+
+      for (Offset i = 0; i < other.mInlineCount; ++i) {
+         mInline.mKeys[i] = other.mInline.mKeys[i];
+         mInline.mValues[i] = ::std::move(other.mInline.mValues[i]);
+      }
+
+      mInlineCount = other.mInlineCount;
+      other.Reset();
+      return *this;
+   }
+
+   /// Get the number of pairs                                                
+   ///   @return the number of pairs                                          
+   TEMPLATE() LANGULUS(INLINED)
+   Count MAP()::GetCount() const noexcept {
+      return mOverflown ? mMap.GetCount() : mInlineCount;
+   }
+
+   /// Check if map has no pairs                                              
+   ///   @return true if empty                                                
+   TEMPLATE() LANGULUS(INLINED)
+   bool MAP()::IsEmpty() const noexcept {
+      return not GetCount();
+   }
+
+   /// Check if pairs have overflown to the hash map                          
+   ///   @return true if the hash map is in use                               
+   TEMPLATE() LANGULUS(INLINED)
+   bool MAP()::IsOverflown() const noexcept {
+      return mOverflown;
+   }
+
+   /// Check if map has any pairs                                             
+   ///   @return true if not empty                                            
+   TEMPLATE() LANGULUS(INLINED)
+   MAP()::operator bool() const noexcept {
+      return not IsEmpty();
+   }
+
+   /// Compare two maps, regardless of the order of pairs                     
+   ///   @param rhs - the map to compare with                                 
+   ///   @return true if both maps contain the same pairs                     
+   TEMPLATE()
+   bool MAP()::operator == (const TSmallMap& rhs) const {
+      if (GetCount() != rhs.GetCount())
+         return false;
+
+      for (auto pair : *this) {
+         const auto found = rhs.FindIt(pair.mKey);
+         if (not found or not (found.GetValue() == pair.mValue))
+            return false;
+      }
+
+      return true;
+   }
+
+   /// Get the sorting order of a key                                         
+   ///   @param key - the meta definition to order                            
+   ///   @return the address of the definition                                
+   TEMPLATE() LANGULUS(INLINED)
+   uintptr_t MAP()::Order(const K& key) noexcept {
+      return reinterpret_cast<uintptr_t>(&*key);
+   }
+
+   /// Find the inline slot, where a key is, or should be inserted            
+   ///   @param key - the key to search for                                   
+   ///   @return the index of the first key, that isn't ordered before key    
+   TEMPLATE() LANGULUS(INLINED)
+   Offset MAP()::LowerBound(const K& key) const noexcept {
+      // Inline arrays are short, so a linear scan beats bisection      
+      const auto order = Order(key);
+      Offset i = 0;
+      while (i < mInlineCount and Order(mInline.mKeys[i]) < order)
+         ++i;
+      return i;
+   }
+
+   /// Move all inline pairs to the hash map, that takes over their storage   
+   TEMPLATE()
+   void MAP()::Overflow() {
+      Map map;
+      for (Offset i = 0; i < mInlineCount; ++i)
+         map.Insert(mInline.mKeys[i], Move(mInline.mValues[i]));
+
+      mInline.~Inline();
+      new (&mMap) Map {::std::move(map)};
+      mInlineCount = 0;
+      mOverflown = true;
+   }
+
+   /// Release the hash map, and switch back to inline pairs                  
+   TEMPLATE()
+   void MAP()::Underflow() noexcept {
+      mMap.~Map();
+      new (&mInline) Inline {};
+      mInlineCount = 0;
+      mOverflown = false;
+   }
+
+   /// Find a pair by key                                                     
+   ///   @param key - the key to search for                                   
+   ///   @return an iterator, that is convertible to false if not found       
+   TEMPLATE()
+   auto MAP()::FindIt(const K& key) -> Iterator<true> {
+      if (mOverflown)
+         return {this, mMap.FindIt(key)};
+
+      const auto i = LowerBound(key);
+      return {this, i < mInlineCount and mInline.mKeys[i] == key ? i : N};
+   }
+
+   /// Find a pair by key (const)                                             
+   ///   @param key - the key to search for                                   
+   ///   @return an iterator, that is convertible to false if not found       
+   TEMPLATE()
+   auto MAP()::FindIt(const K& key) const -> Iterator<false> {
+      if (mOverflown)
+         return {this, mMap.FindIt(key)};
+
+      const auto i = LowerBound(key);
+      return {this, i < mInlineCount and mInline.mKeys[i] == key ? i : N};
+   }
+
+   /// Get a value by key                                                     
+   ///   @attention throws if key doesn't exist                               
+   ///   @param key - the key to search for                                   
+   ///   @return a reference to the value                                     
+   TEMPLATE() LANGULUS(INLINED)
+   auto MAP()::operator[] (const K& key) -> V& {
+      const auto found = FindIt(key);
+      LANGULUS_ASSERT(found, Access, "Key not found in map");
+      return found.GetValue();
+   }
+
+   /// Get a value by key (const)                                             
+   ///   @attention throws if key doesn't exist                               
+   ///   @param key - the key to search for                                   
+   ///   @return a reference to the value                                     
+   TEMPLATE() LANGULUS(INLINED)
+   auto MAP()::operator[] (const K& key) const -> const V& {
+      const auto found = FindIt(key);
+      LANGULUS_ASSERT(found, Access, "Key not found in map");
+      return found.GetValue();
+   }
+
+   /// Insert a pair, overwriting the value if key already exists             
+   ///   @param key - the key to insert                                       
+   ///   @param value - the value, or a single element of it, to insert       
+   ///   @return a reference to the inserted value                            
+   TEMPLATE() template<class T>
+   auto MAP()::Insert(const K& key, T&& value) -> V& {
+      if (mInlineCount == N and not FindIt(key))
+         Overflow();
+
+      if (mOverflown) {
+         mMap.Insert(key, Forward<T>(value));
+         return mMap[key];
+      }
+
+      const auto i = LowerBound(key);
+      if (i == mInlineCount or not (mInline.mKeys[i] == key)) {
+         // Make room for the new key                                   
+         for (Offset j = mInlineCount; j > i; --j) {
+            mInline.mKeys[j] = mInline.mKeys[j - 1];
+            mInline.mValues[j] = ::std::move(mInline.mValues[j - 1]);
+         }
+
+         mInline.mKeys[i] = key;
+         ++mInlineCount;
+      }
+
+      mInline.mValues[i].Reset();
+      if constexpr (CT::Same<T, V>)
+         mInline.mValues[i] = Forward<T>(value);
+      else
+         mInline.mValues[i] << Forward<T>(value);
+      return mInline.mValues[i];
+   }
+
+   /// Push an element to the values of many keys at once, inserting keys     
+   /// that are missing. The map overflows at most once, and only if all      
+   /// missing keys won't fit inline                                          
+   ///   @param keys - the keys to push to, without duplicates                 
+   ///   @param element - the element to push to each of the values           
+   TEMPLATE() template<class KEYS, class T>
+   void MAP()::Append(const KEYS& keys, const T& element) {
+      if (not mOverflown) {
+         Count missing = 0;
+         for (auto& key : keys) {
+            if (not FindIt(key))
+               ++missing;
+         }
+
+         if (mInlineCount + missing > N)
+            Overflow();
+      }
+
+      if (mOverflown) {
+         for (auto& key : keys) {
+            auto found = mMap.FindIt(key);
+            if (found)
+               found.GetValue() << element;
+            else
+               mMap.Insert(key, element);
+         }
+         return;
+      }
+
+      for (auto& key : keys) {
+         const auto i = LowerBound(key);
+         if (i < mInlineCount and mInline.mKeys[i] == key) {
+            mInline.mValues[i] << element;
+            continue;
+         }
+
+         // Make room for the new key                                   
+         for (Offset j = mInlineCount; j > i; --j) {
+            mInline.mKeys[j] = mInline.mKeys[j - 1];
+            mInline.mValues[j] = ::std::move(mInline.mValues[j - 1]);
+         }
+
+         mInline.mKeys[i] = key;
+         mInline.mValues[i].Reset();
+         mInline.mValues[i] << element;
+         ++mInlineCount;
+      }
+   }
+
+   /// Remove a pair via an iterator                                          
+   ///   @param it - the iterator, must be valid                              
+   TEMPLATE()
+   void MAP()::RemoveIt(const Iterator<true>& it) {
+      LANGULUS_ASSUME(DevAssumes, it, "Invalid iterator");
+
+      if (it.mMapIterator) {
+         mMap.RemoveIt(*it.mMapIterator);
+         if (not mMap)
+            Underflow();
+         return;
+      }
+
+      for (Offset j = it.mIndex + 1; j < mInlineCount; ++j) {
+         mInline.mKeys[j - 1] = mInline.mKeys[j];
+         mInline.mValues[j - 1] = ::std::move(mInline.mValues[j]);
+      }
+
+      --mInlineCount;
+      mInline.mKeys[mInlineCount] = {};
+      mInline.mValues[mInlineCount].Reset();
+   }
+
+   /// Remove all pairs and release memory                                    
+   TEMPLATE()
+   void MAP()::Reset() {
+      if (mOverflown) {
+         Underflow();
+         return;
+      }
+
+      for (Offset i = 0; i < mInlineCount; ++i) {
+         mInline.mKeys[i] = {};
+         mInline.mValues[i].Reset();
+      }
+
+      mInlineCount = 0;
+   }
+
+   /// Iterate all values                                                     
+   ///   @param call - the visitor, receives V&, and may return void, bool    
+   ///      or LoopControl                                                    
+   ///   @return the number of visited values                                 
+   TEMPLATE() template<class F>
+   Count MAP()::ForEachValue(F&& call) {
+      Count visited = 0;
+      for (auto pair : *this) {
+         ++visited;
+         if (not Visit(call, pair.mValue))
+            break;
+      }
+
+      return visited;
+   }
+
+   /// Get an iterator to the first pair                                      
+   ///   @return the iterator                                                 
+   TEMPLATE() LANGULUS(INLINED)
+   auto MAP()::begin() -> Iterator<true> {
+      if (mOverflown)
+         return {this, mMap.begin()};
+      return {this, Offset {0}};
+   }
+
+   /// Get an iterator to the first pair (const)                              
+   ///   @return the iterator                                                 
+   TEMPLATE() LANGULUS(INLINED)
+   auto MAP()::begin() const -> Iterator<false> {
+      if (mOverflown)
+         return {this, mMap.begin()};
+      return {this, Offset {0}};
+   }
+
+
+   ///                                                                        
+   ///   Iterator                                                             
+   ///                                                                        
+
+   /// Iterator to an inline pair                                             
+   ///   @param owner - the iterated map                                      
+   ///   @param index - the inline index                                      
+   TEMPLATE() template<bool MUTABLE> LANGULUS(INLINED)
+   MAP()::Iterator<MUTABLE>::Iterator(Owner* owner, Offset index) noexcept
+      : mOwner {owner}
+      , mIndex {index} {}
+
+   /// Iterator to an overflown pair                                          
+   ///   @param owner - the iterated map                                      
+   ///   @param it - the hash map iterator                                    
+   TEMPLATE() template<bool MUTABLE> LANGULUS(INLINED)
+   MAP()::Iterator<MUTABLE>::Iterator(Owner* owner, MapIterator&& it) noexcept
+      : mOwner       {owner}
+      , mMapIterator {::std::move(it)} {}
+
+   /// Check if iterator points to a valid pair                               
+   ///   @return true if valid                                                
+   TEMPLATE() template<bool MUTABLE> LANGULUS(INLINED)
+   MAP()::Iterator<MUTABLE>::operator bool() const noexcept {
+      if (mMapIterator)
+         return static_cast<bool>(*mMapIterator);
+      return mIndex < mOwner->mInlineCount;
+   }
+
+   /// Check if iteration has ended                                           
+   ///   @return true if iterator no longer points to a valid pair            
+   TEMPLATE() template<bool MUTABLE> LANGULUS(INLINED)
+   bool MAP()::Iterator<MUTABLE>::operator == (IteratorEnd) const noexcept {
+      return not static_cast<bool>(*this);
+   }
+
+   /// Get the key the iterator points to                                     
+   ///   @return a reference to the key                                       
+   TEMPLATE() template<bool MUTABLE> LANGULUS(INLINED)
+   auto MAP()::Iterator<MUTABLE>::GetKey() const noexcept -> const K& {
+      if (mMapIterator)
+         return mMapIterator->GetKey();
+      return mOwner->mInline.mKeys[mIndex];
+   }
+
+   /// Get the value the iterator points to                                   
+   ///   @return a reference to the value, mutable only for mutable maps      
+   TEMPLATE() template<bool MUTABLE> LANGULUS(INLINED)
+   auto MAP()::Iterator<MUTABLE>::GetValue() const noexcept -> Reference {
+      if (mMapIterator)
+         return mMapIterator->GetValue();
+      return mOwner->mInline.mValues[mIndex];
+   }
+
+   /// Get the pair the iterator points to                                    
+   ///   @return the key and a reference to the value                         
+   TEMPLATE() template<bool MUTABLE> LANGULUS(INLINED)
+   auto MAP()::Iterator<MUTABLE>::operator * () const noexcept -> Pair<MUTABLE> {
+      return {GetKey(), GetValue()};
+   }
+
+   /// Move to the next pair                                                  
+   ///   @return a reference to this iterator                                 
+   TEMPLATE() template<bool MUTABLE> LANGULUS(INLINED)
+   auto MAP()::Iterator<MUTABLE>::operator ++ () noexcept -> Iterator& {
+      if (mMapIterator)
+         ++*mMapIterator;
+      else
+         ++mIndex;
+      return *this;
+   }
+
+} // namespace Langulus::Entity
+
+#undef TEMPLATE
+#undef MAP
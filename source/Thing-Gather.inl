@@ -7,6 +7,7 @@
 ///                                                                           
 #pragma once
 #include "Thing.hpp"
+#include "Runtime.inl"
 #include "Hierarchy-Gather.inl"
 
 
@@ -14,84 +15,207 @@ namespace Langulus::Entity
 {
    
    /// Collects all units of the given type inside the hierarchy              
+   /// See ForEachUnit for the order of units below                           
    ///   @tparam SEEK - where in the hierarchy are we seeking in?             
    ///   @param meta - the units to seek for                                  
    ///   @return the gathered units that match the type                       
    template<Seek SEEK>
    TMany<A::Unit*> Thing::GatherUnits(DMeta meta) {
       TMany<A::Unit*> result;
+      ForEachUnit<SEEK>(meta, [&](A::Unit* unit) {
+         result << unit;
+      });
+      return result;
+   }
+      
+   /// Collects handles to all units of the given type inside the hierarchy   
+   /// in a dense array, that can be kept across frames and threads           
+   ///   @tparam SEEK - where in the hierarchy are we seeking in?             
+   ///   @param meta - the units to seek for                                  
+   ///   @return the handles of the units that match the type                 
+   template<Seek SEEK>
+   auto Thing::GatherUnitHandles(DMeta meta) -> TMany<UnitHandle> {
+      TMany<UnitHandle> handles;
+      ForEachUnit<SEEK>(meta, [&](A::Unit* unit) {
+         handles << unit->GetHandle();
+      });
+      return Abandon(handles);
+   }
+
+   /// Collects all traits of the given type inside the hierarchy             
+   ///   @tparam SEEK - where in the hierarchy are we seeking in?             
+   ///   @param trait - the trait to seek for                                 
+   ///   @return the gathered traits that match the type                      
+   template<Seek SEEK>
+   TMany<Trait> Thing::GatherTraits(TMeta trait) {
+      TMany<Trait> results;
+      ForEachTrait<SEEK>(trait, [&](const Trait& found) {
+         results << found;
+      });
+      return Abandon(results);
+   }
+
+   /// Visit all units of the given type inside the hierarchy, without        
+   /// collecting them in any intermediate container                          
+   /// Units below are visited depth-first. When seeking from the owner of a  
+   /// runtime, only the Things, that are in the runtime's unit registry, are 
+   /// visited, instead of the whole subtree, but the order is the same       
+   ///   @attention the hierarchy shouldn't be changed from inside the visitor
+   ///   @tparam SEEK - where in the hierarchy are we seeking in?             
+   ///   @param meta - the units to seek for                                  
+   ///   @param call - the visitor, may return void, bool or LoopControl      
+   ///   @return the number of visited units                                  
+   template<Seek SEEK, class F> LANGULUS(INLINED)
+   Count Thing::ForEachUnit(DMeta meta, F&& call) {
+      Count visited = 0;
+      VisitUnits<SEEK>(meta, call, visited);
+      return visited;
+   }
+
+   /// Visit all units of the given static type inside the hierarchy          
+   ///   @tparam T - the type of units to seek for                            
+   ///   @tparam SEEK - where in the hierarchy are we seeking in?             
+   ///   @param call - the visitor, receives T*, and may return void, bool    
+   ///      or LoopControl                                                    
+   ///   @return the number of visited units                                  
+   template<CT::Unit T, Seek SEEK, class F> LANGULUS(INLINED)
+   Count Thing::ForEachUnit(F&& call) {
+      return ForEachUnit<SEEK>(MetaDataOf<Decay<T>>(), [&](A::Unit* unit) {
+         return Visit(call, dynamic_cast<Decay<T>*>(unit));
+      });
+   }
+
+   /// Visit all traits of the given type inside the hierarchy, without       
+   /// collecting them in any intermediate container. Unit members, that are  
+   /// equal to another trait of the same Thing, are visited only once        
+   ///   @attention the hierarchy shouldn't be changed from inside the visitor
+   ///   @tparam SEEK - where in the hierarchy are we seeking in?             
+   ///   @param trait - the trait to seek for                                 
+   ///   @param call - the visitor, may return void, bool or LoopControl      
+   ///   @return the number of visited traits                                 
+   template<Seek SEEK, class F> LANGULUS(INLINED)
+   Count Thing::ForEachTrait(TMeta trait, F&& call) {
+      Count visited = 0;
+      VisitTraits<SEEK>(trait, call, visited);
+      return visited;
+   }
 
+   /// Recursive routine behind ForEachUnit                                   
+   ///   @tparam SEEK - where in the hierarchy are we seeking in?             
+   ///   @param meta - the units to seek for                                  
+   ///   @param call - the visitor                                            
+   ///   @param visited - [in/out] incremented for each visited unit          
+   ///   @return false if the visitor requested to stop                       
+   template<Seek SEEK, class F>
+   bool Thing::VisitUnits(DMeta meta, F& call, Count& visited) {
       if constexpr (SEEK & Seek::Here) {
          // Seek here if requested                                      
-         const auto found = mUnitsAmbiguous.Find(meta);
+         const auto found = mUnitsAmbiguous.FindIt(meta);
          if (found) {
-            auto& list = mUnitsAmbiguous.GetValue(found);
-            for (auto& unit : list)
-               result << unit;
+            for (auto unit : found.GetValue()) {
+               ++visited;
+               if (not Visit(call, unit))
+                  return false;
+            }
          }
       }
 
       if constexpr (SEEK & Seek::Above) {
          // Seek in parents up to root, if requested                    
-         if (mOwner) {
-            auto inParents = mOwner->template
-               GatherUnits<Seek::HereAndAbove>(meta);
-            result += Abandon(inParents);
-         }
+         if (mOwner and not mOwner->template
+            VisitUnits<Seek::HereAndAbove>(meta, call, visited))
+            return false;
       }
 
       if constexpr (SEEK & Seek::Below) {
+         if (mRuntime != nullptr and mRuntime->GetOwner() == this) {
+            // Units registered in the runtime (and the ones nested in  
+            // it) are below its owner, so visit only the Things that   
+            // have matching units, instead of every Thing in subtree   
+            for (auto owner : GatherRegisteredOwners(meta)) {
+               if (not owner->template
+                  VisitUnits<Seek::Here>(meta, call, visited))
+                  return false;
+            }
+            return true;
+         }
+
          // Seek children, if requested                                 
-         for (auto& child : mChildren) {
-            auto inChildren = child->template 
-               GatherUnits<Seek::HereAndBelow>(meta);
-            result += Abandon(inChildren);
+         for (auto child : mChildren) {
+            if (not child->template
+               VisitUnits<Seek::HereAndBelow>(meta, call, visited))
+               return false;
          }
       }
 
-      return result;
+      return true;
    }
-      
-   /// Collects all traits of the given type inside the hierarchy             
+
+   /// Recursive routine behind ForEachTrait                                  
    ///   @tparam SEEK - where in the hierarchy are we seeking in?             
    ///   @param trait - the trait to seek for                                 
-   ///   @return the gathered traits that match the type                      
-   template<Seek SEEK>
-   TMany<Trait> Thing::GatherTraits(TMeta trait) {
-      TMany<Trait> results;
+   ///   @param call - the visitor                                            
+   ///   @param visited - [in/out] incremented for each visited trait         
+   ///   @return false if the visitor requested to stop                       
+   template<Seek SEEK, class F>
+   bool Thing::VisitTraits(TMeta trait, F& call, Count& visited) {
+      // Account for a match, and check if visitor wants to continue    
+      const auto visit = [&](const Trait& found) {
+         ++visited;
+         return Visit(call, found);
+      };
 
       if constexpr (SEEK & Seek::Here) {
          // Handle some predefined traits here                          
          if (trait->template Is<Traits::Unit>()) {
-            // Gather all units                                         
-            for (auto& unit : mUnitsList)
-               results << Traits::Unit {unit};
+            // Visit all units                                          
+            for (auto& unit : mUnitsList) {
+               if (not visit(Traits::Unit {unit}))
+                  return false;
+            }
          }
          else if (trait->template Is<Traits::Child>()) {
-            // Gather all children                                      
-            for (auto& child : mChildren)
-               results << Traits::Unit {child};
+            // Visit all children                                       
+            for (auto& child : mChildren) {
+               if (not visit(Traits::Unit {child}))
+                  return false;
+            }
          }
          else if (trait->template Is<Traits::Runtime>()) {
             // Get the nearest runtime                                  
-            results << Traits::Runtime {*mRuntime};
+            if (not visit(Traits::Runtime {*mRuntime}))
+               return false;
          }
          else if (trait->template Is<Traits::Parent>()) {
             // Get the parent                                           
-            results << Traits::Parent {*mOwner};
+            if (not visit(Traits::Parent {*mOwner}))
+               return false;
          }
 
          // Check dynamic traits in the entity                          
-         const auto found = mTraits.Find(trait);
-         if (found)
-            results += mTraits.GetValue(found);
+         const auto found = mTraits.FindIt(trait);
+         if (found) {
+            for (auto& t : found.GetValue()) {
+               if (not visit(t))
+                  return false;
+            }
+         }
 
-         // Then check each unit's static traits                        
+         // Then check each unit's static traits. Members equal to a    
+         // trait, that was already visited here, are merged, just like 
+         // GatherTraits always did                                     
+         TraitList members;
          for (auto& unit : mUnitsList) {
             Offset index {};
             auto t = unit->GetMember(trait, index);
             while (t) {
-               results <<= Trait::From(trait, t);
+               auto member = Trait::From(trait, t);
+               if (not (found and found.GetValue().Find(member))
+               and not members.Find(member)) {
+                  if (not visit(member))
+                     return false;
+                  members << Abandon(member);
+               }
                t = unit->GetMember(trait, ++index);
             }
          }
@@ -99,21 +223,21 @@ namespace Langulus::Entity
 
       if constexpr (SEEK & Seek::Above) {
          // Seek in parents up to root, if requested                    
-         if (mOwner) {
-            results += mOwner->template
-               GatherTraits<Seek::HereAndAbove>(trait);
-         }
+         if (mOwner and not mOwner->template
+            VisitTraits<Seek::HereAndAbove>(trait, call, visited))
+            return false;
       }
 
       if constexpr (SEEK & Seek::Below) {
          // Seek children, if requested                                 
          for (auto& child : mChildren) {
-            results += child->template
-               GatherTraits<Seek::HereAndBelow>(trait);
+            if (not child->template
+               VisitTraits<Seek::HereAndBelow>(trait, call, visited))
+               return false;
          }
       }
 
-      return Abandon(results);
+      return true;
    }
 
    /// Gather all traits/members convertible to a type                        
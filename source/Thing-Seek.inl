@@ -12,14 +12,82 @@
 
 namespace Langulus::Entity
 {
-   
+
+   /// Invalidate the seek caches of this Thing and all Things below it       
+   /// Called on any change of units or traits here, and when the Thing is    
+   /// attached to or detached from an owner                                  
+   LANGULUS(INLINED)
+   void Thing::InvalidateSeeks() noexcept {
+      mChangedAt = mHierarchyGeneration.fetch_add(1, ::std::memory_order_relaxed) + 1;
+   }
+
+   /// Find a memoized seek result                                            
+   /// Drops the entire cache, only if this Thing or any of its owners has    
+   /// changed since the cache was last validated. Changes elsewhere cost a   
+   /// single walk up the owners, after which hits are O(1) again             
+   ///   @param key - the seek to search for                                  
+   ///   @return the cached result, or nullptr if seek wasn't memoized        
+   LANGULUS(INLINED)
+   auto Thing::FindSeek(const SeekKey& key) const -> const SeekHit* {
+      const auto generation = mHierarchyGeneration.load(::std::memory_order_relaxed);
+      if (mSeekGeneration != generation) {
+         const auto validated = mSeekGeneration;
+         mSeekGeneration = generation;
+
+         for (auto t = this; t; t = t->mOwner ? &*t->mOwner : nullptr) {
+            if (t->mChangedAt > validated) {
+               mSeekCache.Clear();
+               return nullptr;
+            }
+         }
+      }
+
+      const auto found = mSeekCache.FindIt(key);
+      return found ? &found.GetValue() : nullptr;
+   }
+
+   /// Memoize a seek result                                                  
+   ///   @param key - the seek to memoize                                     
+   ///   @param result - the found unit, or the Thing that provided the       
+   ///      trait or value                                                    
+   LANGULUS(INLINED)
+   void Thing::CacheSeek(const SeekKey& key, const void* result) const {
+      mSeekCache.Insert(key, SeekHit {result});
+   }
+
    /// Find a specific unit, searching into the hierarchy                     
+   /// Upward seeks are memoized in the seeking Thing, until the hierarchy    
+   /// changes                                                                
    ///   @tparam SEEK - where in the hierarchy are we seeking in?             
    ///   @param meta - the unit to seek for                                   
    ///   @param offset - which of the matches to return                       
    ///   @return the found unit, or nullptr if no such unit was found         
    template<Seek SEEK>
    auto Thing::SeekUnit(DMeta meta, Index offset) -> A::Unit* {
+      if constexpr (not (SEEK & Seek::Below)) {
+         if (offset.IsArithmetic()) {
+            const SeekKey key {
+               meta, nullptr, static_cast<Offset>(SEEK), offset.GetOffsetUnsafe()
+            };
+
+            if (const auto hit = FindSeek(key))
+               return static_cast<A::Unit*>(const_cast<void*>(hit->mResult));
+
+            // Climb the hierarchy without touching the owners' caches  
+            A::Unit* result = nullptr;
+            Thing* provider = SEEK & Seek::Here ? this
+               : (mOwner ? &*mOwner : nullptr);
+
+            while (provider and not result) {
+               result = provider->GetUnitMeta(meta, offset);
+               provider = provider->mOwner ? &*provider->mOwner : nullptr;
+            }
+
+            CacheSeek(key, result);
+            return result;
+         }
+      }
+
       A::Unit* result = nullptr;
       if constexpr (SEEK & Seek::Here) {
          // Seek here if requested                                      
@@ -155,12 +223,45 @@ namespace Langulus::Entity
    }
 
    /// Find a trait by type (and index), searching into the hierarchy         
+   /// Upward seeks memoize the Thing that provided the trait, so that the    
+   /// trait itself is always up to date                                      
    ///   @tparam SEEK - direction to search at                                
    ///   @param meta - the trait to search for                                
    ///   @param offset - the offset to apply                                  
    ///   @return the trait, which is not empty, if trait was found            
    template<Seek SEEK>
    auto Thing::SeekTrait(TMeta meta, Index offset) -> Trait {
+      if constexpr (not (SEEK & Seek::Below)) {
+         if (offset.IsArithmetic()) {
+            const SeekKey key {
+               meta, nullptr, static_cast<Offset>(SEEK), offset.GetOffsetUnsafe()
+            };
+
+            if (const auto hit = FindSeek(key)) {
+               auto provider = static_cast<Thing*>(const_cast<void*>(hit->mResult));
+               auto output = provider->GetTrait(meta, offset);
+               if (output)
+                  return Abandon(output);
+            }
+
+            // Climb the hierarchy without touching the owners' caches  
+            Thing* provider = SEEK & Seek::Here ? this
+               : (mOwner ? &*mOwner : nullptr);
+
+            while (provider) {
+               auto output = provider->GetTrait(meta, offset);
+               if (output) {
+                  CacheSeek(key, provider);
+                  return Abandon(output);
+               }
+
+               provider = provider->mOwner ? &*provider->mOwner : nullptr;
+            }
+
+            return {};
+         }
+      }
+
       if constexpr (SEEK & Seek::Here) {
          // Seek here if requested                                      
          auto output = GetTrait(meta, offset);
@@ -221,9 +322,42 @@ namespace Langulus::Entity
       return SeekTrait<SEEK>(meta, offset);
    }
    
+   /// Read a trait from this Thing only, and attempt converting it to a      
+   /// desired output type                                                    
+   /// Supports pinnable outputs                                              
+   ///   @param meta - the trait type to search for                           
+   ///   @param output - [out] the output                                     
+   ///   @param offset - the number of the matching trait to use              
+   ///   @return true if output was rewritten                                 
+   template<class D>
+   bool Thing::ReadValue(TMeta meta, D& output, Index offset) const {
+      auto temp = GetTrait(meta, offset);
+      if (CT::Pinnable<D> and temp.Is<TypeOf<D>>()) {
+         output = temp.As<TypeOf<D>>();
+         return true;
+      }
+      else if (not CT::Pinnable<D> and temp.Is<D>()) {
+         output = temp.As<D>();
+         return true;
+      }
+      else if constexpr (CT::DescriptorMakable<D>)
+         return TryDescribe(static_cast<const Many&>(temp), output);
+      else if constexpr (CT::Pinnable<D>) {
+         // Conversions never throw, and known failures aren't retried  
+         TypeOf<D> converted;
+         if (not TryConvert(temp, converted))
+            return false;
+         output = ::std::move(converted);
+         return true;
+      }
+      else return TryConvert(temp, output);
+   }
+
    /// Find a trait by type (and index) from the hierarchy, and attempt       
    /// converting it to a desired output type                                 
    /// Supports pinnable outputs                                              
+   /// Upward seeks memoize the Thing that provided the value, so that the    
+   /// value itself is always up to date                                      
    ///   @tparam SEEK - direction to search at                                
    ///   @param meta - the trait type to search for                           
    ///   @param output - [out] the output                                     
@@ -239,24 +373,40 @@ namespace Langulus::Entity
             return false;
       }
 
+      if constexpr (not (SEEK & Seek::Below)) {
+         if (offset.IsArithmetic()) {
+            const SeekKey key {
+               meta, MetaDataOf<D>(), static_cast<Offset>(SEEK),
+               offset.GetOffsetUnsafe()
+            };
+
+            if (const auto hit = FindSeek(key)) {
+               auto provider = static_cast<const Thing*>(hit->mResult);
+               if (provider->ReadValue(meta, output, offset))
+                  return true;
+            }
+
+            // Climb the hierarchy without touching the owners' caches  
+            const Thing* provider = SEEK & Seek::Here ? this
+               : (mOwner ? &*mOwner : nullptr);
+
+            while (provider) {
+               if (provider->ReadValue(meta, output, offset)) {
+                  CacheSeek(key, provider);
+                  return true;
+               }
+
+               provider = provider->mOwner ? &*provider->mOwner : nullptr;
+            }
+
+            return false;
+         }
+      }
+
       if constexpr (SEEK & Seek::Here) {
          // Seek here if requested                                      
-         auto temp = GetTrait(meta, offset);
-         try {
-            if (CT::Pinnable<D> and temp.Is<TypeOf<D>>())
-               output = temp.As<TypeOf<D>>();
-            else if (not CT::Pinnable<D> and temp.Is<D>())
-               output = temp.As<D>();
-            else if constexpr (CT::DescriptorMakable<D>)
-               output = D {Describe(static_cast<const Many&>(temp))};
-            else if constexpr (CT::Pinnable<D>)
-               output = temp.template AsCast<TypeOf<D>>();
-            else
-               output = temp.template AsCast<D>();
-
+         if (ReadValue(meta, output, offset))
             return true;
-         }
-         catch (...) { }
       }
 
       if constexpr (SEEK & Seek::Above) {
@@ -301,24 +451,30 @@ namespace Langulus::Entity
             return false;
       }
 
+      // Conversions never throw, and known failures aren't retried     
+      const auto convert = [&output](const Many& data) {
+         if constexpr (CT::Pinnable<D>) {
+            TypeOf<D> converted;
+            if (not TryConvert(data, converted))
+               return false;
+            output = ::std::move(converted);
+            return true;
+         }
+         else return TryConvert(data, output);
+      };
+
       // Scan descriptor                                                
       bool done = false;
       if (meta) {
          aux.ForEachDeep([&](const Trait& trait) {
             if (trait.IsTrait(meta)) {
                // Found match                                           
-               try {
-                  if constexpr (CT::Pinnable<D>)
-                     output = trait.template AsCast<TypeOf<D>>();
-                  else
-                     output = trait.template AsCast<D>();
-
-                  // Didn't throw, but we're done only if offset matches
+               if (convert(trait)) {
+                  // Converted, but we're done only if offset matches   
                   done = offset == 0;
                   --offset;
                   return done ? Loop::Break : Loop::Continue;
                }
-               catch (...) {}
             }
 
             return Loop::Continue;
@@ -326,19 +482,12 @@ namespace Langulus::Entity
       }
       else {
          aux.ForEachDeep([&](const Many& group) {
-            try {
-               // Found match if these don't throw                      
-               if constexpr (CT::Pinnable<D>)
-                  output = group.template AsCast<TypeOf<D>>();
-               else
-                  output = group.template AsCast<D>();
-
-               // Didn't throw, but we're done only if offset matches   
+            if (convert(group)) {
+               // Found match, but we're done only if offset matches    
                done = offset == 0;
                --offset;
                return done ? Loop::Break : Loop::Continue;
             }
-            catch(...) {}
 
             return Loop::Continue;
          });
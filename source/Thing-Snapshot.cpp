@@ -0,0 +1,347 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Thing.hpp"
+#include "Thing.inl"
+#include <cstring>
+
+#if LANGULUS_FEATURE(MANAGED_REFLECTION)
+
+namespace Langulus::Entity
+{
+   namespace
+   {
+
+      /// Snapshot header, written once at the start of the snapshot          
+      struct SnapshotHeader {
+         char     mMagic[4];
+         // SnapshotByteOrder, as written by the saving host            
+         uint32_t mByteOrder;
+         uint32_t mVersion;
+      };
+
+      constexpr char SnapshotMagic[4] {'L', 'T', 'H', 'G'};
+      /// Reads back differently on a host with another byte order            
+      constexpr uint32_t SnapshotByteOrder = 0x01020304;
+
+      /// Check if a type is exactly one of the given types                   
+      ///   @param type - the type to check                                   
+      ///   @return true if type is one of T                                  
+      template<class...T>
+      bool IsAnyOf(DMeta type) {
+         return (type->template IsExact<T>() or ...);
+      }
+
+      /// How a block of data is encoded in the snapshot                      
+      enum class Encoding : uint8_t {
+         // Dense POD data, written as raw bytes                        
+         POD,
+         // Text elements, each written as a length and letters         
+         Text,
+         // Data that can't be encoded, written as nothing              
+         Skipped
+      };
+
+      /// Check if data of a type can be written as raw bytes, and read back  
+      /// by another process. Pointers, POD that might hold them, and handles,
+      /// that are issued per runtime, can't be                               
+      ///   @param type - the type to check                                   
+      ///   @return true if data can be written as raw bytes                  
+      bool IsPortablePOD(DMeta type) {
+         if (not type or not type->mIsPOD or type->mIsSparse)
+            return false;
+         if (type == MetaDataOf<ThingHandle>() or type == MetaDataOf<UnitHandle>())
+            return false;
+
+         Size covered {};
+         for (auto& member : type->mMembers) {
+            const auto memberType = member.GetType();
+            if (not IsPortablePOD(memberType))
+               return false;
+            covered += memberType->mSize * member.mCount;
+         }
+
+         // Bytes, that aren't covered by reflected members, might hold    
+         // pointers, so only fundamental types may reflect no members     
+         if (type->mMembers.empty()) {
+            return IsAnyOf<bool, Byte, Letter, char8_t, char16_t, char32_t,
+               wchar_t, ::std::int8_t, ::std::uint8_t, ::std::int16_t,
+               ::std::uint16_t, ::std::int32_t, ::std::uint32_t,
+               ::std::int64_t, ::std::uint64_t, float, double>(type);
+         }
+
+         return covered == type->mSize;
+      }
+
+      ///                                                                     
+      ///   Appends snapshot data to a byte buffer                            
+      ///                                                                     
+      class SnapshotWriter {
+         Bytes& mBytes;
+
+      public:
+         SnapshotWriter(Bytes& bytes)
+            : mBytes {bytes} {}
+
+         void Write(const void* data, Size size) {
+            if (not size)
+               return;
+
+            const auto at = mBytes.GetCount();
+            mBytes.New(size);
+            ::std::memcpy(mBytes.GetRaw() + at, data, size);
+         }
+
+         template<class T>
+         void Write(const T& value) {
+            Write(&value, sizeof(T));
+         }
+
+         void WriteToken(const Token& token) {
+            Write(static_cast<uint32_t>(token.size()));
+            Write(token.data(), token.size());
+         }
+
+         /// Write the type and contents of a block                           
+         ///   @param block - the block to write                              
+         void WriteBlock(const CT::Block auto& block) {
+            const auto type = block.GetType();
+            WriteToken(type ? type->mToken : Token {});
+            Write(static_cast<uint32_t>(block.GetCount()));
+
+            if (not block.IsSparse() and IsPortablePOD(type)) {
+               Write(Encoding::POD);
+               Write(block.GetRaw(), block.GetCount() * type->mSize);
+            }
+            else if (type and not block.IsSparse() and block.template Is<Text>()) {
+               Write(Encoding::Text);
+               for (Offset i = 0; i < block.GetCount(); ++i)
+                  WriteToken(Token {block.template As<Text>(i)});
+            }
+            else {
+               Logger::Warning("Snapshot skips data of type `", type, '`');
+               Write(Encoding::Skipped);
+            }
+         }
+      };
+
+      ///                                                                     
+      ///   Reads snapshot data from bytes, without copying it                
+      ///                                                                     
+      class SnapshotReader {
+         const Byte* mCursor;
+         const Byte* mEnd;
+
+      public:
+         SnapshotReader(const Bytes& bytes)
+            : mCursor {bytes.GetRaw()}
+            , mEnd    {bytes.GetRaw() + bytes.GetCount()} {}
+
+         /// Get a view of the next bytes, and skip them                      
+         ///   @param size - number of bytes                                  
+         ///   @return a pointer to the bytes inside the snapshot             
+         auto Take(Size size) -> const Byte* {
+            LANGULUS_ASSERT(static_cast<Size>(mEnd - mCursor) >= size, Access,
+               "Snapshot is truncated");
+            const auto data = mCursor;
+            mCursor += size;
+            return data;
+         }
+
+         template<class T>
+         T Read() {
+            T value;
+            ::std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+            return value;
+         }
+
+         auto ReadToken() -> Token {
+            const auto size = Read<uint32_t>();
+            return {reinterpret_cast<const Letter*>(Take(size)), size};
+         }
+
+         NOD() bool IsDone() const noexcept {
+            return mCursor == mEnd;
+         }
+      };
+
+      /// Read the contents of a block, that were written by                  
+      /// SnapshotWriter::WriteBlock, into an existing block, or into a       
+      /// newly created trait                                                 
+      ///   @tparam PREALLOCATED - whether target already contains the        
+      ///      elements, as is the case for unit members                      
+      ///   @param reader - the reader                                        
+      ///   @param type - the type of the contents                            
+      ///   @param count - the number of elements                             
+      ///   @param target - the block to fill; must have count elements if    
+      ///      preallocated, otherwise elements are pushed                    
+      template<bool PREALLOCATED>
+      void ReadBlock(SnapshotReader& reader, DMeta type, Count count,
+         CT::Block auto& target
+      ) {
+         switch (reader.Read<Encoding>()) {
+         case Encoding::POD: {
+            LANGULUS_ASSERT(IsPortablePOD(type), Access,
+               "Snapshot has raw data of type `", type, "`, that isn't portable");
+
+            // Bulk copy straight from the snapshot                     
+            const auto size = count * type->mSize;
+            const auto data = reader.Take(size);
+            if constexpr (not PREALLOCATED)
+               target.New(count);
+            if (size)
+               ::std::memcpy(target.GetRaw(), data, size);
+            break;
+         }
+         case Encoding::Text:
+            for (Offset i = 0; i < count; ++i) {
+               Text text {reader.ReadToken()};
+               if constexpr (PREALLOCATED)
+                  target.template As<Text>(i) = Abandon(text);
+               else
+                  target << Abandon(text);
+            }
+            break;
+         case Encoding::Skipped:
+            break;
+         default:
+            LANGULUS_THROW(Access, "Bad snapshot encoding");
+         }
+      }
+
+      /// Save a Thing and its children, without a header                     
+      ///   @param thing - the Thing to save                                  
+      ///   @param writer - the writer to write to                            
+      void SaveThing(const Thing& thing, SnapshotWriter& writer) {
+         // Traits                                                      
+         Count traitCount {};
+         for (auto pair : thing.GetTraits())
+            traitCount += pair.mValue.GetCount();
+
+         writer.Write(static_cast<uint32_t>(traitCount));
+         for (auto pair : thing.GetTraits()) {
+            for (auto& trait : pair.mValue) {
+               writer.WriteToken(trait.GetTrait()
+                  ? trait.GetTrait()->mToken : Token {});
+               writer.WriteBlock(trait);
+            }
+         }
+
+         // Units, along with all their reflected members               
+         writer.Write(static_cast<uint32_t>(thing.GetUnits().GetCount()));
+         for (auto unit : thing.GetUnits()) {
+            writer.WriteToken(unit->GetType()->mToken);
+
+            Count memberCount {};
+            while (unit->GetMember(TMeta {}, memberCount))
+               ++memberCount;
+
+            writer.Write(static_cast<uint32_t>(memberCount));
+            for (Offset i = 0; i < memberCount; ++i)
+               writer.WriteBlock(unit->GetMember(TMeta {}, i));
+         }
+
+         // Children                                                    
+         writer.Write(static_cast<uint32_t>(thing.GetChildren().GetCount()));
+         for (auto child : thing.GetChildren())
+            SaveThing(*child, writer);
+      }
+
+      /// Load a Thing and its children, without a header                     
+      ///   @param thing - the Thing to load into                             
+      ///   @param reader - the reader to read from                           
+      void LoadThing(Thing& thing, SnapshotReader& reader) {
+         // Traits                                                      
+         const auto traitCount = reader.Read<uint32_t>();
+         for (uint32_t i = 0; i < traitCount; ++i) {
+            const auto traitType = RTTI::GetMetaTrait(reader.ReadToken());
+            const auto dataType = RTTI::GetMetaData(reader.ReadToken());
+            const auto count = reader.Read<uint32_t>();
+
+            Trait trait = Trait::FromMeta(traitType, dataType);
+            ReadBlock<false>(reader, dataType, count, trait);
+            thing.AddTrait(Abandon(trait));
+         }
+
+         // Units - each unit is created with default members, that are 
+         // then overwritten with the saved ones                        
+         const auto unitCount = reader.Read<uint32_t>();
+         for (uint32_t i = 0; i < unitCount; ++i) {
+            const auto unitToken = reader.ReadToken();
+            const auto before = thing.GetUnits().GetCount();
+            (void) thing.CreateUnitToken(unitToken);
+            LANGULUS_ASSERT(thing.GetUnits().GetCount() > before, Construct,
+               "Unable to create unit `", unitToken, "` from snapshot");
+            auto unit = thing.GetUnits()[before];
+
+            const auto memberCount = reader.Read<uint32_t>();
+            for (uint32_t m = 0; m < memberCount; ++m) {
+               const auto memberType = RTTI::GetMetaData(reader.ReadToken());
+               const auto count = reader.Read<uint32_t>();
+               auto member = unit->GetMember(TMeta {}, m);
+               LANGULUS_ASSERT(member.GetType() == memberType
+                  and member.GetCount() == count, Access,
+                  "Member #", m, " of `", unitToken, "` doesn't match snapshot");
+               ReadBlock<true>(reader, memberType, count, member);
+            }
+         }
+
+         // Children                                                    
+         const auto childCount = reader.Read<uint32_t>();
+         for (uint32_t i = 0; i < childCount; ++i)
+            LoadThing(*thing.CreateChild(), reader);
+      }
+
+   } // namespace Langulus::Entity::<anonymous>
+
+   /// Save the Thing, along with all of its children, as a binary snapshot   
+   /// Saved are traits, the types of units along with their reflected        
+   /// members, and the child topology. Dense POD data is written as is,      
+   /// so that loading it is a plain memory copy                              
+   ///   @attention runtimes and flows aren't saved, neither is data that     
+   ///      isn't POD or text, nor POD that holds pointers or handles - such  
+   ///      data is skipped with a warning                                    
+   ///   @attention POD is written in the byte order of the host, so          
+   ///      snapshots can only be loaded on hosts with the same byte order    
+   ///   @return the snapshot bytes                                           
+   auto Thing::Save() const -> Bytes {
+      Bytes bytes;
+      SnapshotWriter writer {bytes};
+
+      SnapshotHeader header {};
+      ::std::memcpy(header.mMagic, SnapshotMagic, sizeof(SnapshotMagic));
+      header.mByteOrder = SnapshotByteOrder;
+      header.mVersion = SnapshotVersion;
+      writer.Write(header);
+      SaveThing(*this, writer);
+      return bytes;
+   }
+
+   /// Load a binary snapshot, made by Thing::Save, into this Thing           
+   /// The snapshot is only read, never copied                                
+   ///   @attention units are created via producers, so modules that          
+   ///      produce the saved units must be available in the hierarchy        
+   ///   @param bytes - the snapshot                                          
+   void Thing::Load(const Bytes& bytes) {
+      SnapshotReader reader {bytes};
+      const auto header = reader.Read<SnapshotHeader>();
+      LANGULUS_ASSERT(0 == ::std::memcmp(header.mMagic, SnapshotMagic,
+         sizeof(SnapshotMagic)), Access, "Not a Thing snapshot");
+      LANGULUS_ASSERT(header.mByteOrder == SnapshotByteOrder, Access,
+         "Snapshot was saved on a host with a different byte order");
+      LANGULUS_ASSERT(header.mVersion == SnapshotVersion, Access,
+         "Unsupported snapshot version ", header.mVersion,
+         " (expected ", SnapshotVersion, ')');
+
+      LoadThing(*this, reader);
+      LANGULUS_ASSERT(reader.IsDone(), Access,
+         "Snapshot has trailing data");
+   }
+
+} // namespace Langulus::Entity
+
+#endif
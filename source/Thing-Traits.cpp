@@ -36,6 +36,9 @@ namespace Langulus::Entity
    auto Thing::GetLocalTrait(TMeta id, Index index) -> Trait* {
       if (id) {
          // Search a typed trait                                        
+         if (not mTypeMask.MayContain(GetTypeIndex(id)))
+            return nullptr;
+
          const auto found = mTraits.FindIt(id);
          if (found)
             return &(found.GetValue()[index]);
@@ -122,14 +125,23 @@ namespace Langulus::Entity
    auto Thing::AddTrait(Trait trait) -> Trait* {
       const auto tmeta = trait.GetTrait();
       auto found = mTraits.FindIt(tmeta);
+      InvalidateSeeks();
+      MarkDirty(GetTypeIndex(tmeta));
+      if (mRuntime != nullptr)
+         mRuntime->IndexTrait(trait, this);
+
       if (found) {
          found.GetValue() << trait;
+         NotifyChange({Change::TraitAdded, this, nullptr, tmeta});
          return &found.GetValue().Last();
       }
 
       mTraits.Insert(tmeta, trait);
-      mRefreshRequired = true;
+      mTypeMask.Set(GetTypeIndex(tmeta));
+      if (trait.template IsTrait<Traits::Name>())
+         ReindexName();
       ENTITY_VERBOSE_SELF(trait, " added");
+      NotifyChange({Change::TraitAdded, this, nullptr, tmeta});
       return &mTraits[tmeta].Last();
    }
 
@@ -140,9 +152,19 @@ namespace Langulus::Entity
       const auto found = mTraits.FindIt(trait);
       if (found) {
          const auto removed = found.GetValue().GetCount();
+         NotifyChange({Change::TraitRemoved, this, nullptr, trait});
+         if (mRuntime != nullptr) {
+            for (auto& value : found.GetValue())
+               mRuntime->UnindexTrait(value, this);
+         }
+
          mTraits.RemoveIt(found);
+         UpdateTypeMask();
          ENTITY_VERBOSE_SELF(trait, " removed");
-         mRefreshRequired = true;
+         MarkDirty(GetTypeIndex(trait));
+         InvalidateSeeks();
+         if (trait == MetaTraitOf<Traits::Name>())
+            ReindexName();
          return removed;
       }
 
@@ -155,10 +177,21 @@ namespace Langulus::Entity
    auto Thing::RemoveTrait(Trait trait) -> Count {
       const auto found = mTraits.FindIt(trait.GetTrait());
       if (found) {
+         if (found.GetValue().Find(trait))
+            NotifyChange({Change::TraitRemoved, this, nullptr, trait.GetTrait()});
+
          const auto removed = found.GetValue().Remove(trait);
          if (removed) {
+            if (mRuntime != nullptr) {
+               for (Count i = 0; i < removed; ++i)
+                  mRuntime->UnindexTrait(trait, this);
+            }
+
             ENTITY_VERBOSE_SELF(trait, " removed");
-            mRefreshRequired = true;
+            MarkDirty(GetTypeIndex(trait.GetTrait()));
+            InvalidateSeeks();
+            if (trait.template IsTrait<Traits::Name>())
+               ReindexName();
             return removed;
          }
       }
@@ -170,6 +203,9 @@ namespace Langulus::Entity
    ///   @param trait - type of trait to check                                
    ///   @return the number of matching traits                                
    auto Thing::HasTraits(TMeta trait) const -> Count {
+      if (trait and not mTypeMask.MayContain(GetTypeIndex(trait)))
+         return 0;
+
       const auto found = mTraits.FindIt(trait);
       return found ? found.GetValue().GetCount() : 0;
    }
@@ -197,20 +233,46 @@ namespace Langulus::Entity
       return mTraits;
    }
 
+   /// Overwrite the first local trait of the same type, or add it            
+   /// Prefer this to changing traits via GetLocalTrait, so that trait        
+   /// indexes in the runtime remain up to date                               
+   ///   @param trait - the trait to set                                      
+   ///   @return the changed or added trait                                   
+   auto Thing::SetTrait(Trait trait) -> Trait* {
+      auto found = GetLocalTrait(trait.GetTrait());
+      if (not found)
+         return AddTrait(trait);
+
+      if (mRuntime != nullptr)
+         mRuntime->UnindexTrait(*found, this);
+      *found = trait;
+      if (mRuntime != nullptr)
+         mRuntime->IndexTrait(*found, this);
+
+      MarkDirty(GetTypeIndex(trait.GetTrait()));
+      InvalidateSeeks();
+      if (trait.template IsTrait<Traits::Name>())
+         ReindexName();
+      ENTITY_VERBOSE_SELF(trait, " changed");
+      NotifyChange({Change::TraitChanged, this, nullptr, trait.GetTrait()});
+      return found;
+   }
+
    /// Add/overwrite entity's name trait                                      
    ///   @param name - the name to set                                        
    void Thing::SetName(const Text& name) {
-      auto found = GetLocalTrait<Traits::Name>();
-      if (not found)
-         AddTrait(Traits::Name {name});
-      else
-         *found = name;
+      SetTrait(Traits::Name {name});
    }
 
    /// Get entity's name trait, if any                                        
    /// It can reside in one of the units                                      
    ///   @return the name, or empty string if no such trait was found here    
    Text Thing::GetName() const {
+      // Fast path for the usual case of a local textual name           
+      const auto local = GetLocalTrait<Traits::Name>();
+      if (local and local->template Is<Text>())
+         return local->template As<Text>();
+
       Text name;
       SeekValue<Traits::Name, Seek::Here>(name);
       return name;
@@ -82,7 +82,25 @@ namespace Langulus::Entity
    void Thing::Create(Verb& verb) {
       if (not verb)
          return;
-      CreateInner(verb, verb.GetArgument());
+
+      if (mRuntime != nullptr) {
+         // Use the descriptor, compiled by the runtime                 
+         CreateFromPrefab(verb, mRuntime->GetPrefab(verb.GetArgument()));
+      }
+      else CreateInner(verb, verb.GetArgument());
+   }
+
+   /// Create stuff inside entity's context, by executing a compiled          
+   /// descriptor. Remembers the prefab if it makes the whole Thing, so that  
+   /// the Thing can be recycled                                              
+   ///   @param verb - creation verb, whose argument the prefab was made of   
+   ///   @param prefab - the compiled descriptor                              
+   void Thing::CreateFromPrefab(
+      Verb& verb, const ::std::shared_ptr<const Prefab>& prefab
+   ) {
+      const bool pristine = not mChildren and not mUnitsList and not mTraits;
+      prefab->Execute(*this, verb);
+      mPrefab = pristine ? prefab : nullptr;
    }
 
    /// Pick something from the entity - children, traits, units, modules      
@@ -90,6 +108,46 @@ namespace Langulus::Entity
    /// in all parents, climbing the hierarchy                                 
    ///   @param verb - the selection verb                                     
    void Thing::Select(Verb& verb) {
+      // Gather the types the argument requires, in the same order the  
+      // probe below visits them, and reject this Thing straight away,  
+      // if its type mask shows it doesn't have all of them             
+      TypeMask required;
+      const auto requireTrait = [&](const TMeta& trait) {
+         // Traits, that GetTrait makes up, aren't in the mask          
+         if (trait
+         and trait != MetaTraitOf<Traits::Unit>()
+         and trait != MetaTraitOf<Traits::Child>()
+         and trait != MetaTraitOf<Traits::Runtime>()
+         and trait != MetaTraitOf<Traits::Parent>())
+            required.Set(GetTypeIndex(trait));
+         return Loop::Continue;
+      };
+
+      verb.ForEachDeep(
+         [&](const Construct& construct) {
+            if (not construct.Is<Thing>() and construct.CastsTo<A::Unit>())
+               required.Set(GetTypeIndex(construct.GetType()));
+            return Loop::Break;
+         },
+         [&](const Trait& trait) {
+            return requireTrait(trait.GetTrait());
+         },
+         [&](const TMeta& trait) {
+            return requireTrait(trait);
+         },
+         [&](const DMeta& type) {
+            if (type and not type->Is<Thing>())
+               required.Set(GetTypeIndex(type));
+            return Loop::Continue;
+         }
+      );
+
+      if (not GetTypeMask().MayContainAll(required)) {
+         if (mOwner)
+            mOwner->Select(verb);
+         return;
+      }
+
       // Probe every part of the argument and check if it matches       
       TMany<Trait>    selectedTraits;
       TMany<A::Unit*> selectedUnits;
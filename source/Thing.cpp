@@ -7,11 +7,15 @@
 ///                                                                           
 #include "Thing.hpp"
 #include "Thing.inl"
+#include <algorithm>
 
 
 namespace Langulus::Entity
 {
 
+   /// The global hierarchy generation, used to invalidate seek caches        
+   ::std::atomic<Count> Thing::mHierarchyGeneration {1};
+
    /// Default-constructor, always creates a parentless root thing            
    Thing::Thing() : Resolvable {this} {
       ENTITY_VERBOSE_SELF("Created (root, ", GetReferences(), " references)");
@@ -87,18 +91,39 @@ namespace Langulus::Entity
       , mFlow           {Move(other.mFlow)}
       , mChildren       {Move(other.mChildren)}
       , mUnitsList      {Move(other.mUnitsList)}
-      , mUnitsAmbiguous {Move(other.mUnitsAmbiguous)}
-      , mTraits         {Move(other.mTraits)}
+      , mUnitsAmbiguous {::std::move(other.mUnitsAmbiguous)}
+      , mTraits         {::std::move(other.mTraits)}
+      , mTypeMask       {other.mTypeMask}
       , mRefreshRequired{true}
+      , mUnitSlots      {::std::move(other.mUnitSlots)}
+      , mUnorderedRemoval{other.mUnorderedRemoval}
+      , mNameIndex      {Move(other.mNameIndex)}
+      , mUnindexedNames {other.mUnindexedNames}
    {
       // Remap children                                                 
+      InvalidateSeeks();
+      mChangedTypes.SetAll();
       for (auto& child : mChildren)
          child->mOwner = this;
 
       // Remap units                                                    
+      other.mHandlers.Reset();
       for (auto& unit : mUnitsList)
          unit->ReplaceOwner(&other, this);
 
+      if (mRuntime != nullptr) {
+         UnregisterUnits(&*mRuntime, &other);
+         RegisterUnits(&*mRuntime);
+         UnindexTraits(&*mRuntime, &other);
+         IndexTraits(&*mRuntime);
+         mRuntime->ForgetChanges(&other);
+
+         // Handles follow the moved Thing                              
+         ::std::swap(mHandle, other.mHandle);
+         if (mHandle)
+            mRuntime->RebindHandle(mHandle, this);
+      }
+
       // Make sure the losing parent is notified of the change          
       if (other.mOwner)
          other.mOwner->RemoveChild(&other);
@@ -117,11 +142,18 @@ namespace Langulus::Entity
       , mFlow           {Abandon(other->mFlow)}
       , mChildren       {Abandon(other->mChildren)}
       , mUnitsList      {Abandon(other->mUnitsList)}
-      , mUnitsAmbiguous {Abandon(other->mUnitsAmbiguous)}
-      , mTraits         {Abandon(other->mTraits)}
+      , mUnitsAmbiguous {::std::move(other->mUnitsAmbiguous)}
+      , mTraits         {::std::move(other->mTraits)}
+      , mTypeMask       {other->mTypeMask}
       , mRefreshRequired{true}
+      , mUnitSlots      {::std::move(other->mUnitSlots)}
+      , mUnorderedRemoval{other->mUnorderedRemoval}
+      , mNameIndex      {Abandon(other->mNameIndex)}
+      , mUnindexedNames {other->mUnindexedNames}
    {
       // Remap children                                                 
+      InvalidateSeeks();
+      mChangedTypes.SetAll();
       for (auto& child : mChildren)
          child->mOwner = this;
 
@@ -129,6 +161,19 @@ namespace Langulus::Entity
       for (auto& unit : mUnitsList)
          unit->ReplaceOwner(&*other, this);
 
+      if (mRuntime != nullptr) {
+         UnregisterUnits(&*mRuntime, &*other);
+         RegisterUnits(&*mRuntime);
+         UnindexTraits(&*mRuntime, &*other);
+         IndexTraits(&*mRuntime);
+         mRuntime->ForgetChanges(&*other);
+
+         // Handles follow the abandoned Thing                          
+         ::std::swap(mHandle, other->mHandle);
+         if (mHandle)
+            mRuntime->RebindHandle(mHandle, this);
+      }
+
       // Make sure the losing parent is notified of the change          
       if (other->mOwner)
          other->mOwner->RemoveChild(&*other);
@@ -143,15 +188,131 @@ namespace Langulus::Entity
    ///   @param other - clone that entity                                     
    Thing::Thing(Cloned<Thing>&& other)
       : Resolvable      {this}
-      , mChildren       {Clone(other->mChildren)}
       , mRefreshRequired{true}
    {
-      TODO();
-      //TODO clone flow and runtime if pinned, recreate modules if new runtime, 
-      // recreate units and traits, then recreate children
+      if (other->mOwner) {
+         // The clone becomes a sibling of the original                 
+         mRuntime = other->mOwner->GetRuntime();
+         mFlow = other->mOwner->GetFlow();
+      }
+
+      // Attach before cloning contents, so that units can be produced  
+      // by producers in the ancestors of the clone                     
+      if (other->mOwner)
+         other->mOwner->AddChild(this);
+      CloneFrom(*other);
       ENTITY_VERBOSE_SELF("Cloned from ", *other);
    }
 
+   /// Clone the contents of another Thing into this freshly created one      
+   /// Pinned runtime and flow are recreated, along with all modules of the   
+   /// runtime. Otherwise, the runtime and flow of this Thing's parent are    
+   /// used, or the ones of the source, if this Thing has no parent.          
+   /// Traits are deep-copied, units are produced again by their producers,   
+   /// using their reflected members as descriptors, and children are cloned  
+   /// recursively                                                            
+   ///   @param source - the Thing to clone                                   
+   void Thing::CloneFrom(const Thing& source) {
+      TUnorderedMap<const A::Unit*, A::Unit*> clones;
+      CloneFrom(source, clones);
+   }
+
+   /// Clone the contents of another Thing, sharing units between clones      
+   /// Units, that are shared by several Things in the cloned hierarchy, are  
+   /// produced only once, and are shared by the clones of their owners       
+   ///   @param source - the Thing to clone                                   
+   ///   @param clones - the units cloned so far, indexed by their source     
+   void Thing::CloneFrom(
+      const Thing& source, TUnorderedMap<const A::Unit*, A::Unit*>& clones
+   ) {
+      if (source.mRuntime.IsLocked()) {
+         CreateRuntime();
+         mRuntime->CloneModules(*source.mRuntime);
+      }
+      else if (mRuntime == nullptr)
+         mRuntime = source.mRuntime;
+
+      if (source.mFlow.IsLocked())
+         CreateFlow();
+      else if (mFlow == nullptr)
+         mFlow = source.mFlow;
+
+      Reserve(source.mChildren.GetCount(), source.mUnitsList.GetCount());
+      for (auto pair : source.mTraits) {
+         for (auto& trait : pair.mValue)
+            AddTrait(Clone(trait));
+      }
+
+      for (auto unit : source.mUnitsList) {
+         const bool shared = unit->GetOwners().GetCount() > 1;
+         if (shared) {
+            const auto found = clones.FindIt(unit);
+            if (found) {
+               AddUnit(found.GetValue());
+               continue;
+            }
+         }
+
+         Many descriptor;
+         Offset index {};
+         auto member = unit->GetMember(TMeta {}, index);
+         while (member) {
+            descriptor << Clone(member);
+            member = unit->GetMember(TMeta {}, ++index);
+         }
+
+         const auto before = mUnitsList.GetCount();
+         (void) CreateData(Construct {unit->GetType(), Abandon(descriptor)});
+         if (shared and mUnitsList.GetCount() > before)
+            clones.Insert(unit, mUnitsList[before]);
+      }
+
+      for (auto child : source.mChildren) {
+         Ref<Thing> copy;
+         copy.New(this);
+         copy->CloneFrom(*child, clones);
+      }
+
+      MarkDirty();
+   }
+
+   /// Reserve room for more children and units, so that adding them          
+   /// doesn't grow the containers one at a time                              
+   ///   @param children - the number of children to make room for            
+   ///   @param units - the number of units to make room for                  
+   void Thing::Reserve(Count children, Count units) {
+      if (children)
+         mChildren.Reserve(mChildren.GetCount() + children);
+
+      if (units) {
+         mUnitsList.Reserve(mUnitsList.GetCount() + units);
+         mUnitSlots.reserve(mUnitSlots.size() + units);
+      }
+   }
+
+   /// Clone this Thing multiple times                                        
+   /// Containers for the copies are reserved once, so that the copies are    
+   /// allocated in a single pass, instead of growing on each clone           
+   ///   @param count - the number of copies to make                          
+   ///   @param parent - the Thing to add the copies to, or nullptr to make   
+   ///      them roots                                                        
+   ///   @return the copies                                                   
+   auto Thing::CloneN(Count count, Thing* parent) const -> Hierarchy {
+      Hierarchy copies;
+      copies.Reserve(count);
+      if (parent)
+         parent->Reserve(count);
+
+      for (Offset i = 0; i < count; ++i) {
+         Ref<Thing> copy;
+         copy.New(parent);
+         copy->CloneFrom(*this);
+         copies << &*copy;
+      }
+
+      return copies;
+   }
+
    /// Destroy the thing                                                      
    Thing::~Thing() {
       // First stage destruction that severs all connections            
@@ -199,12 +360,29 @@ namespace Langulus::Entity
       // Reset owner, so that only one reference to this Thing remains  
       // in the hierarchy: the owner's mChildren                        
       mOwner.Reset();
+      mSeekCache.Reset();
+      mNameIndex.Reset();
+      mUnindexedNames = 0;
+      mIndexedName.Reset();
+      mUnindexedName = false;
+      InvalidateSeeks();
 
       // Traits might be exposing members in units. Make sure we        
       // dereference those first, so that units have as small number of 
       // references as possible                                         
       ENTITY_VERBOSE_SELF("Tearing off traits (name might change)");
+      UnindexTraits(mRuntime != nullptr ? &*mRuntime : nullptr, this);
       mTraits.Reset();
+      UpdateTypeMask();
+
+      // Handles no longer resolve, once the Thing is torn down         
+      ReleaseHandle(mRuntime != nullptr ? &*mRuntime : nullptr);
+
+      // Remove units from the runtime's registry, while it's still     
+      // guaranteed to be alive                                         
+      UnregisterUnits(mRuntime != nullptr ? &*mRuntime : nullptr, this);
+      if (mRuntime != nullptr)
+         mRuntime->ForgetChanges(this);
 
       // Decouple all units from this owner because units might get     
       // destroyed upon destroying mUnitsList and mUnitsAmbiguous, if   
@@ -217,8 +395,10 @@ namespace Langulus::Entity
             "Tearing off unit ", unit, " at ", unit->GetReferences(), " uses...");
          unit->mOwners.Remove(this);
 
-         if (unit->mOwners.IsEmpty())
+         if (unit->mOwners.IsEmpty()) {
+            ReleaseUnitHandle(unit);
             unit->mOwners.Reset();
+         }
       }
 
       // Propagate Teardown through the hierarchy of Things             
@@ -308,45 +488,287 @@ namespace Langulus::Entity
       }
 
       // Cascade the update down the hierarchy                          
+      // Pin::Get() isn't used here, it throws for pinned runtimes      
+      bool result = true;
+      if (mRuntime != nullptr and mRuntime->IsParallelUpdate()
+      and mChildren.GetCount() > 1)
+         result = UpdateParallel(deltaTime, mRuntime->GetScheduler());
+      else {
+         for (auto& child : mChildren) {
+            if (not child->Update(deltaTime)) {
+               result = false;
+               break;
+            }
+         }
+      }
+
+      if (mRuntime.IsLocked()) {
+         // Apply structural changes, that were deferred while the      
+         // hierarchy was being updated. This is the only sync point,   
+         // so refresh happens once, at the start of the next update    
+         mRuntime->FlushCommands();
+      }
+
+      return result;
+   }
+
+   /// Update children in parallel. Each child that owns its runtime is an    
+   /// independent subtree, and is submitted as a separate task. The rest of  
+   /// the children share this Thing's runtime - its unit registry, indexes,  
+   /// observers and prefabs aren't guarded, so these children are updated    
+   /// on this thread in the meantime                                         
+   ///   @attention unlike the sequential update, all subtrees are updated    
+   ///      even if one of them requests an exit, so that the outcome doesn't 
+   ///      depend on the order in which tasks were executed                  
+   ///   @param deltaTime - how much time passes for the simulation           
+   ///   @param scheduler - the scheduler to submit subtrees to               
+   ///   @return true if no exit was requested by any of the subtrees         
+   bool Thing::UpdateParallel(Time deltaTime, Scheduler& scheduler) {
+      ::std::atomic<bool> exitRequested {};
+      Scheduler::Group subtrees;
+
       for (auto& child : mChildren) {
-         if (not child->Update(deltaTime))
-            return false;
+         if (not child->mRuntime.IsLocked())
+            continue;
+
+         Thing* subtree = child;
+         scheduler.Submit(subtrees, [subtree, deltaTime, &exitRequested] {
+            if (not subtree->Update(deltaTime))
+               exitRequested.store(true, ::std::memory_order_relaxed);
+         });
+      }
+
+      try {
+         for (auto& child : mChildren) {
+            if (child->mRuntime.IsLocked())
+               continue;
+
+            if (not child->Update(deltaTime))
+               exitRequested.store(true, ::std::memory_order_relaxed);
+         }
+      }
+      catch (...) {
+         // Never leave tasks referencing this stack frame              
+         try { scheduler.Wait(subtrees); }
+         catch (...) {}
+         throw;
       }
 
-      return true;
+      scheduler.Wait(subtrees);
+      return not exitRequested.load(::std::memory_order_relaxed);
    }
 
-   /// Refresh all units and children down the hierarchy                      
-   ///   @param force - force refresh                                         
+   /// Refresh units down the hierarchy, that might be affected by changes    
+   /// Only subtrees, that contain changed Things, are visited. In and below  
+   /// a changed Thing, only units that sought any of the changed types       
+   /// since their last refresh are refreshed - see A::Unit::GetDependencies  
+   ///   @param force - refresh all units in the hierarchy, regardless of     
+   ///      whether they're affected or not                                   
    void Thing::Refresh(bool force) {
-      if (not force and not mRefreshRequired)
+      if (force) {
+         RefreshSubtree(nullptr);
          return;
+      }
+
+      if (mRefreshRequired) {
+         const TypeMask nothingAbove;
+         RefreshSubtree(&nothingAbove);
+         return;
+      }
+
+      if (not mRefreshBelow.load(::std::memory_order_relaxed))
+         return;
+
+      // Nothing changed here, just find the changed Things below       
+      mRefreshBelow.store(false, ::std::memory_order_relaxed);
+      for (auto& child : mChildren)
+         child->Refresh();
+   }
+
+   /// Refresh this Thing and everything below it, after types have changed   
+   /// here, or somewhere above it                                            
+   ///   @param above - the types, that have changed above this Thing, or     
+   ///      nullptr if anything might have changed                            
+   void Thing::RefreshSubtree(const TypeMask* above) {
+      TypeMask changed = mChangedTypes;
+      if (above)
+         changed.Merge(*above);
 
       mRefreshRequired = false;
+      mRefreshBelow.store(false, ::std::memory_order_relaxed);
+      mChangedTypes.Reset();
 
-      // Refresh all units                                              
-      for (auto& unit : mUnitsList)
+      // Refresh units, that depend on any of the changed types, or     
+      // were never refreshed. Dependencies are recorded anew           
+      for (auto& unit : mUnitsList) {
+         if (above and unit->mDependenciesKnown
+         and not unit->mDependencies.Intersects(changed))
+            continue;
+
+         unit->mDependencies.Reset();
+         unit->mDependenciesKnown = true;
          unit->Refresh();
+      }
 
       // And cascade down the hierarchy                                 
-      for (auto& child : mChildren)
-         child->Refresh(true);
+      for (auto& child : mChildren) {
+         if (not above)
+            child->RefreshSubtree(nullptr);
+         else if (changed.IsEmpty())
+            child->Refresh();
+         else
+            child->RefreshSubtree(&changed);
+      }
+   }
+
+   /// Mark a type as changed in this Thing, so that the next Refresh()       
+   /// refreshes the units here, as well as units below, that seek it         
+   ///   @param type - the dense index of the changed trait or unit type      
+   void Thing::MarkDirty(Offset type) {
+      mChangedTypes.Set(type);
+      mRefreshRequired = true;
+      if (mOwner)
+         mOwner->MarkDirtyBelow();
+   }
+
+   /// Mark everything as changed in this Thing, so that the next Refresh()   
+   /// refreshes all units here and below                                     
+   void Thing::MarkDirty() {
+      mChangedTypes.SetAll();
+      mRefreshRequired = true;
+      if (mOwner)
+         mOwner->MarkDirtyBelow();
+   }
+
+   /// Let this Thing and all of its owners know, that something below them   
+   /// requires a refresh. Stops at the first owner, that already knows       
+   /// Subtrees updated in parallel share their owners, hence the atomics     
+   void Thing::MarkDirtyBelow() noexcept {
+      Thing* owner = this;
+      while (owner and not owner->mRefreshBelow.load(::std::memory_order_relaxed)) {
+         owner->mRefreshBelow.store(true, ::std::memory_order_relaxed);
+         owner = owner->mOwner ? &*owner->mOwner : nullptr;
+      }
+   }
+
+   /// Report a change in this Thing to the observers of its runtime          
+   ///   @param change - the change to report                                 
+   void Thing::NotifyChange(const Change& change) {
+      if (mRuntime != nullptr)
+         mRuntime->NotifyChange(change);
    }
 
-   /// Reset the entity, clearing all children, units, traits                 
+   /// Reset the entity, clearing all children, units, traits, and releasing  
+   /// the memory of the containers                                           
    void Thing::Reset() {
+      Clear();
+      mChildren.Reset();
+      mUnitsList.Reset();
+      mSeekCache.Reset();
+   }
+
+   /// Clear the entity of all children, units and traits, like Reset, but    
+   /// keep the memory of the containers, so that refilling them is cheaper   
+   void Thing::Clear() {
+      // Report before removing, children and units might get destroyed 
+      for (auto& child : mChildren) {
+         if (child->mOwner == this)
+            NotifyChange({Change::ChildDetached, this, nullptr, {}, child});
+      }
+      for (auto& unit : mUnitsList)
+         NotifyChange({Change::UnitRemoved, this, unit});
+      for (auto pair : mTraits)
+         NotifyChange({Change::TraitRemoved, this, nullptr, pair.mKey});
+
       // Decouple all children from this parent                         
-      for (auto& child : mChildren)
+      for (auto& child : mChildren) {
+         if (child->mOwner == this)
+            child->mChildSlot = 0;
          child->mOwner.Reset();
+         child->mIndexedName.Reset();
+         child->mUnindexedName = false;
+      }
 
       // Decouple all units from this owner                             
-      for (auto& unit : mUnitsList)
+      UnregisterUnits(mRuntime != nullptr ? &*mRuntime : nullptr, this);
+      UnindexTraits(mRuntime != nullptr ? &*mRuntime : nullptr, this);
+      for (auto& unit : mUnitsList) {
          unit->mOwners.Remove(this);
+         ReleaseUnitHandle(unit);
+      }
 
-      mChildren.Reset();
-      mUnitsList.Reset();
+      mChildren.Clear();
+      mNameIndex.Clear();
+      mUnindexedNames = 0;
+      mUnitsList.Clear();
+      mUnitSlots.clear();
       mUnitsAmbiguous.Reset();
+      mHandlers.Reset();
+      ++mUnitChanges;
       mTraits.Reset();
+      mTypeMask.Reset();
+      mSeekCache.Clear();
+      InvalidateSeeks();
+      ReindexName();
+      MarkDirty();
+   }
+
+   /// Destroy this Thing, by detaching it from its owner. If the runtime     
+   /// has a pool of Things, and this Thing was made from a prefab, it is     
+   /// cleared and parked in the pool instead, keeping the memory of its      
+   /// containers, so that Thing::CreateChild reuses it for the same prefab   
+   ///   @attention the Thing shouldn't be used after recycling it, even if   
+   ///      it's still referenced, because it might get reused at any time    
+   void Thing::Recycle() {
+      // Keep this Thing alive, while it's being detached               
+      const Ref<Thing> self {this};
+      if (mOwner)
+         mOwner->RemoveChild(this);
+
+      // Own runtimes and flows can't be parked                         
+      if (not mPrefab or mRuntime == nullptr
+      or  mRuntime.IsLocked() or mFlow.IsLocked())
+         return;
+
+      // Check for room before clearing, so that a Thing, that can't be 
+      // parked, is left intact                                         
+      const auto pool = mRuntime->GetThingPool();
+      if (not pool or not pool->HasRoom(&*mPrefab))
+         return;
+
+      // A parked Thing is a different Thing, once it's reused          
+      ReleaseHandle(&*mRuntime);
+      Clear();
+      // Another thread might fill the pool in the meantime, and then   
+      // the cleared Thing is simply destroyed with its last reference  
+      if (pool->Park(this, &*mPrefab)) {
+         // Parked Things must not keep the runtime alive               
+         mRuntime->ForgetChanges(this);
+         mRuntime.Reset();
+         mFlow.Reset();
+         ENTITY_VERBOSE_SELF("Parked for reuse");
+      }
+   }
+
+   /// Take a Thing, made from the same prefab as the descriptor, from the    
+   /// runtime's pool of Things, and make it a child of this one              
+   ///   @attention assumes this Thing has a runtime with a pool              
+   ///   @param descriptor - instructions for creating the child              
+   ///   @param prefab - the descriptor, compiled by the runtime              
+   ///   @return the reused child, or nothing if no such Thing was parked     
+   auto Thing::ReuseChild(
+      const Many& descriptor, const ::std::shared_ptr<const Prefab>& prefab
+   ) -> Ref<Thing> {
+      auto child = mRuntime->GetThingPool()->Take(&*prefab);
+      if (not child)
+         return child;
+
+      AddChild(&*child);
+      child->mFlow = GetFlow();
+      Verbs::Create creator {descriptor};
+      child->CreateFromPrefab(creator, prefab);
+      ENTITY_VERBOSE_SELF(child, " reused as child");
+      return child;
    }
 
    /// Get a unit by type and offset                                          
@@ -366,6 +788,46 @@ namespace Langulus::Entity
       return mUnitsList[index];
    }
 
+   /// Get the units, that are able to handle a verb                          
+   /// A unit is able to handle a verb if it has a custom dispatcher, or if   
+   /// it or any of its bases reflect the verb. Verbs with a default          
+   /// implementation, or without a type, can be handled by any unit          
+   ///   @param verb - the type of the verb                                   
+   ///   @return the units, in order of addition; the list is shared with     
+   ///      the cache, and remains valid even if units change meanwhile       
+   auto Thing::GetHandlers(VMeta verb) const -> UnitList {
+      if (verb) {
+         const auto found = mHandlers.FindIt(verb);
+         if (found)
+            return found.GetValue();
+      }
+
+      const bool anyone = not verb
+         or verb->mDefaultInvocationMutable
+         or verb->mDefaultInvocationConstant;
+
+      UnitList handlers;
+      for (auto unit : mUnitsList) {
+         const auto type = unit->GetType();
+         bool able = anyone or not type or type->mDispatcher;
+         if (not able) {
+            for (auto base : GetBaseList<A::Unit>(type)) {
+               if (base->mAbilities.find(verb) != base->mAbilities.end()) {
+                  able = true;
+                  break;
+               }
+            }
+         }
+
+         if (able)
+            handlers << unit;
+      }
+
+      if (verb)
+         mHandlers.Insert(verb, handlers);
+      return handlers;
+   }
+
    auto Thing::GetUnitMeta(DMeta type, Index offset) const -> const A::Unit* {
       return const_cast<Thing*>(this)->GetUnitMeta(type, offset);
    }
@@ -448,13 +910,42 @@ namespace Langulus::Entity
    }
 
    /// Get child by name and offset (searches for Traits::Name in children)   
+   /// Matches are counted in the order of mChildren                          
    ///   @param name - name to seek                                           
    ///   @param offset - offset to seek                                       
    ///   @return the child entity, or nullptr of none was found               
    auto Thing::GetNamedChild(const Token& name, Index offset) -> Thing* {
       Index matches = 0;
-      for (auto& child : mChildren) {
-         if (child->GetName() == name) {
+      const auto found = mNameIndex.FindIt(Text {Disown(name)});
+      if (not mUnindexedNames) {
+         // All named children are indexed, so the index is enough      
+         if (not found)
+            return nullptr;
+
+         for (auto child : found.GetValue()) {
+            if (matches == offset)
+               return child;
+            ++matches;
+         }
+
+         return nullptr;
+      }
+
+      // Some children might be named by their units, so walk all of    
+      // them in order, following the indexed ones in parallel, and     
+      // getting the names only of those that might be named otherwise  
+      Offset next = 0;
+      for (auto child : mChildren) {
+         bool match = false;
+         if (child->mUnindexedName)
+            match = child->GetName() == name;
+         else if (found and next < found.GetValue().GetCount()
+              and found.GetValue()[next] == child) {
+            match = true;
+            ++next;
+         }
+
+         if (match) {
             if (matches == offset)
                return child;
             ++matches;
@@ -468,14 +959,153 @@ namespace Langulus::Entity
       return const_cast<Thing*>(this)->GetNamedChild(name, offset);
    }
 
+   /// Find a descendant by a path of names, separated by '/'                 
+   /// The path is relative to this Thing, and empty segments are ignored,    
+   /// so "level/room42/door" finds the first child named "door", inside      
+   /// the first "room42", inside the first "level" child                     
+   ///   @param path - the path to follow                                     
+   ///   @return the found descendant, or nullptr if path doesn't exist       
+   auto Thing::FindByPath(const Token& path) -> Thing* {
+      Thing* current = this;
+      Offset start = 0;
+      while (current and start <= path.size()) {
+         auto end = path.find('/', start);
+         if (end == Token::npos)
+            end = path.size();
+
+         if (end > start)
+            current = current->GetNamedChild(path.substr(start, end - start));
+         start = end + 1;
+      }
+
+      return current;
+   }
+
+   auto Thing::FindByPath(const Token& path) const -> const Thing* {
+      return const_cast<Thing*>(this)->FindByPath(path);
+   }
+
+   /// Get the name of this Thing, only if it is a local textual trait        
+   ///   @return the name, or an empty token                                  
+   auto Thing::GetLocalName() const -> Token {
+      const auto local = GetLocalTrait<Traits::Name>();
+      if (local and local->template Is<Text>())
+         return Token {local->template As<Text>()};
+      return {};
+   }
+
+   /// Check if this Thing might be named, even though it has no local        
+   /// textual name - by its units, or by a name that isn't text              
+   ///   @return true if GetName has to be consulted                          
+   bool Thing::IsNamedIndirectly() const {
+      return mUnitsList or GetLocalTrait<Traits::Name>();
+   }
+
+   /// Insert a child in the name index, by its local name                    
+   /// The per-name lists are kept in the order of mChildren. Children,       
+   /// that might be named otherwise, are only counted                        
+   ///   @param child - the child to index                                    
+   void Thing::IndexChild(Thing* child) {
+      const auto local = child->GetLocalTrait<Traits::Name>();
+      if (not local or not local->template Is<Text>()
+      or  local->template As<Text>().IsEmpty()) {
+         if (child->IsNamedIndirectly()) {
+            child->mUnindexedName = true;
+            ++mUnindexedNames;
+         }
+         return;
+      }
+
+      child->mIndexedName = local->template As<Text>();
+      auto found = mNameIndex.FindIt(child->mIndexedName);
+      if (not found) {
+         TMany<Thing*> list;
+         list << child;
+         mNameIndex.Insert(child->mIndexedName, Abandon(list));
+         return;
+      }
+
+      auto& list = found.GetValue();
+      if (mChildren.Last() == child) {
+         // The usual case - appending a new child                      
+         list << child;
+         return;
+      }
+
+      // Renamed in the middle of the children, so restore order        
+      list.Clear();
+      for (auto sibling : mChildren) {
+         if (sibling->mIndexedName == child->mIndexedName)
+            list << sibling;
+      }
+   }
+
+   /// Remove a child from the name index                                     
+   ///   @param child - the child to remove                                   
+   void Thing::UnindexChild(Thing* child) {
+      if (child->mUnindexedName) {
+         child->mUnindexedName = false;
+         --mUnindexedNames;
+      }
+
+      if (not child->mIndexedName)
+         return;
+
+      const auto found = mNameIndex.FindIt(child->mIndexedName);
+      if (found) {
+         auto& list = found.GetValue();
+         list.Remove(child);
+         if (not list)
+            mNameIndex.RemoveIt(found);
+      }
+
+      child->mIndexedName.Reset();
+   }
+
+   /// Update this Thing's entry in its owner's name index, after its name    
+   /// trait, or its units have changed                                       
+   void Thing::ReindexName() {
+      if (not mOwner)
+         return;
+
+      const auto name = GetLocalName();
+      const bool indirect = name.empty() and IsNamedIndirectly();
+      if (indirect == mUnindexedName and name == Token {mIndexedName})
+         return;
+
+      mOwner->UnindexChild(this);
+      mOwner->IndexChild(this);
+   }
+
    /// Do a cascading runtime reset - all children that do not have own       
    /// runtime, will incorporate the provided one                             
    ///   @param newrt - the new runtime to set                                
    void Thing::ResetRuntime(Runtime* newrt) {
-      if (mRuntime.IsLocked())
+      if (mRuntime.IsLocked()) {
+         // Own runtimes are just nested in the new one                 
+         mRuntime->Nest(newrt);
          return;
+      }
+
+      const auto previous = mRuntime != nullptr ? &*mRuntime : nullptr;
+      if (previous != newrt) {
+         // Handles are issued per runtime                              
+         ReleaseHandle(previous);
+         for (auto& unit : mUnitsList) {
+            if (previous and unit->mHandle)
+               previous->ReleaseHandle(unit->mHandle);
+            unit->mHandle = {};
+         }
+
+         UnregisterUnits(previous, this);
+         UnindexTraits(previous, this);
+         if (previous)
+            previous->ForgetChanges(this);
+         mRuntime = newrt;
+         RegisterUnits(newrt);
+         IndexTraits(newrt);
+      }
 
-      mRuntime = newrt;
       for (auto& child : mChildren)
          child->ResetRuntime(newrt);
    }
@@ -492,20 +1122,271 @@ namespace Langulus::Entity
          child->ResetFlow(newflow);
    }
 
+   /// Find the Things below this one, that have units of the given type,     
+   /// through the unit registry of this Thing's runtime. Costs O(matches),   
+   /// instead of walking the entire subtree                                  
+   ///   @attention assumes this Thing owns its runtime                       
+   ///   @param meta - the type of units to search for                        
+   ///   @return the Things, each once, in depth-first hierarchy order        
+   auto Thing::GatherRegisteredOwners(DMeta meta) const -> TMany<Thing*> {
+      // Each Thing below is sorted by its path of child slots from     
+      // here - ancestors come before their descendants, and siblings   
+      // in the order of their owner's mChildren, just like a walk      
+      using Path = ::std::vector<Offset>;
+      ::std::vector<::std::pair<Path, Thing*>> found;
+      mRuntime->ForEachRegisteredUnit(meta, [&](A::Unit*, Thing* owner) {
+         if (owner == this)
+            return;
+
+         Path path;
+         const Thing* step = owner;
+         while (step and step != this) {
+            path.push_back(step->mChildSlot);
+            step = step->mOwner ? &*step->mOwner : nullptr;
+         }
+
+         // Detached Things keep their runtime, hence the check         
+         if (not step)
+            return;
+
+         ::std::reverse(path.begin(), path.end());
+         found.emplace_back(::std::move(path), owner);
+      });
+
+      // Things with several matching units are registered repeatedly   
+      ::std::sort(found.begin(), found.end());
+      TMany<Thing*> result;
+      for (auto& [path, owner] : found) {
+         if (not result or result.Last() != owner)
+            result << owner;
+      }
+      return result;
+   }
+
+   /// Check if this Thing is somewhere below another Thing                   
+   ///   @param ancestor - the Thing to check                                 
+   ///   @return true if ancestor is an owner of this Thing, or an owner of   
+   ///      its owners                                                        
+   bool Thing::IsDescendantOf(const Thing* ancestor) const noexcept {
+      const Thing* owner = mOwner ? &*mOwner : nullptr;
+      while (owner) {
+         if (owner == ancestor)
+            return true;
+         owner = owner->mOwner ? &*owner->mOwner : nullptr;
+      }
+      return false;
+   }
+
+   /// Check if a Thing is a child of this one, without searching for it      
+   ///   @param entity - the Thing to check                                   
+   ///   @return true if entity is in this Thing's children                   
+   bool Thing::HasChild(const Thing* entity) const noexcept {
+      return entity and entity->mChildSlot < mChildren.GetCount()
+         and mChildren[entity->mChildSlot] == entity;
+   }
+
+   /// Get a handle to this Thing, issued by its runtime on first request     
+   /// The handle stays valid, until the Thing is torn down, recycled, or     
+   /// moved to another runtime                                               
+   ///   @return the handle, or an invalid handle if there's no runtime       
+   auto Thing::GetHandle() const -> ThingHandle {
+      if (not mHandle and mRuntime != nullptr)
+         mHandle = mRuntime->IssueHandle(const_cast<Thing*>(this));
+      return mHandle;
+   }
+
+   /// Get the handles of all children, in the order of the children          
+   ///   @return a dense array of handles                                     
+   auto Thing::GatherChildHandles() const -> TMany<ThingHandle> {
+      TMany<ThingHandle> handles;
+      handles.Reserve(mChildren.GetCount());
+      for (auto child : mChildren)
+         handles << child->GetHandle();
+      return Abandon(handles);
+   }
+
+   /// Release the handle of this Thing, so that it no longer resolves        
+   ///   @param runtime - the runtime that issued the handle, can be nullptr  
+   void Thing::ReleaseHandle(Runtime* runtime) {
+      if (runtime and mHandle)
+         runtime->ReleaseHandle(mHandle);
+      mHandle = {};
+   }
+
+   /// Release the handle of a unit, once it's no longer owned by anything    
+   ///   @param unit - the unit, that this Thing has just decoupled from      
+   void Thing::ReleaseUnitHandle(A::Unit* unit) {
+      if (not unit->mHandle or unit->mOwners)
+         return;
+
+      if (mRuntime != nullptr)
+         mRuntime->ReleaseHandle(unit->mHandle);
+      unit->mHandle = {};
+   }
+
+   /// Allow removing children and units by moving the last one in their      
+   /// place, instead of shifting all that follow. Makes removal O(1), which  
+   /// pays off in Things with many children, but doesn't preserve order      
+   ///   @param unordered - true to allow reordering on removal               
+   void Thing::SetUnorderedRemoval(bool unordered) noexcept {
+      mUnorderedRemoval = unordered;
+   }
+
+   /// Check if removing children and units may reorder the rest              
+   ///   @return true if removal is unordered                                 
+   bool Thing::IsUnorderedRemoval() const noexcept {
+      return mUnorderedRemoval;
+   }
+
+   /// Remove a child from its slot, keeping the slots of the rest valid      
+   ///   @attention the child might be destroyed afterwards                   
+   ///   @param slot - the slot of the child to remove                        
+   void Thing::RemoveChildSlot(Offset slot) {
+      const auto last = mChildren.GetCount() - 1;
+      if (mUnorderedRemoval and slot != last) {
+         // Move the last child in the gap                              
+         const auto moved = mChildren[last];
+         moved->mChildSlot = slot;
+         mChildren.Swap(slot, last);
+         mChildren.RemoveIndex(last);
+         if (not moved->mIndexedName)
+            return;
+
+         // The moved child was last in its name list, so bubble it     
+         // back to its place in the order of mChildren                 
+         auto& list = mNameIndex.FindIt(moved->mIndexedName).GetValue();
+         for (auto i = list.GetCount() - 1; i > 0; --i) {
+            if (list[i - 1]->mChildSlot < slot)
+               break;
+            list.Swap(i - 1, i);
+         }
+         return;
+      }
+
+      mChildren.RemoveIndex(slot);
+      for (auto i = slot; i < last; ++i)
+         mChildren[i]->mChildSlot = i;
+   }
+
+   /// Remove a unit from its slot, keeping the slots of the rest valid       
+   ///   @attention the unit might be destroyed afterwards                    
+   ///   @param slot - the slot of the unit to remove                         
+   void Thing::RemoveUnitSlot(Offset slot) {
+      const auto last = mUnitsList.GetCount() - 1;
+      mUnitSlots.erase(mUnitsList[slot]);
+      if (mUnorderedRemoval and slot != last) {
+         // Move the last unit in the gap                               
+         mUnitSlots[mUnitsList[last]] = slot;
+         mUnitsList.Swap(slot, last);
+         mUnitsList.RemoveIndex(last);
+         return;
+      }
+
+      mUnitsList.RemoveIndex(slot);
+      for (auto i = slot; i < last; ++i)
+         mUnitSlots[mUnitsList[i]] = i;
+   }
+
+   /// Register all units of this Thing in a runtime's unit registry          
+   ///   @param runtime - the runtime to register in, can be nullptr          
+   void Thing::RegisterUnits(Runtime* runtime) {
+      if (not runtime)
+         return;
+
+      for (auto pair : mUnitsAmbiguous) {
+         for (auto unit : pair.mValue)
+            runtime->RegisterUnit(pair.mKey, unit, this);
+      }
+
+      runtime->NotifyUnitsChanged(this);
+   }
+
+   /// Unregister all units of this Thing from a runtime's unit registry      
+   ///   @param runtime - the runtime to unregister from, can be nullptr      
+   ///   @param owner - the owner the units were registered with              
+   void Thing::UnregisterUnits(Runtime* runtime, Thing* owner) {
+      if (not runtime)
+         return;
+
+      for (auto pair : mUnitsAmbiguous) {
+         for (auto unit : pair.mValue)
+            runtime->UnregisterUnit(pair.mKey, unit, owner);
+      }
+
+      runtime->NotifyUnitsRemoved(owner);
+   }
+
+   /// Index all traits of this Thing in a runtime's trait indexes            
+   ///   @param runtime - the runtime to index in, can be nullptr             
+   void Thing::IndexTraits(Runtime* runtime) {
+      if (not runtime)
+         return;
+
+      for (auto pair : mTraits) {
+         if (not runtime->GetTraitIndex(pair.mKey))
+            continue;
+
+         for (auto& trait : pair.mValue)
+            runtime->IndexTrait(trait, this);
+      }
+   }
+
+   /// Remove all traits of this Thing from a runtime's trait indexes         
+   ///   @param runtime - the runtime to remove from, can be nullptr          
+   ///   @param owner - the owner the traits were indexed with                
+   void Thing::UnindexTraits(Runtime* runtime, Thing* owner) {
+      if (not runtime)
+         return;
+
+      for (auto pair : mTraits) {
+         if (not runtime->GetTraitIndex(pair.mKey))
+            continue;
+
+         for (auto& trait : pair.mValue)
+            runtime->UnindexTrait(trait, owner);
+      }
+   }
+
    /// Count the number of matching units in this entity                      
    ///   @param type - the type of units to search for                        
    ///   @return the number of matching units                                 
    auto Thing::HasUnits(DMeta type) const -> Count {
+      if (type and not mTypeMask.MayContain(GetTypeIndex(type)))
+         return 0;
+
       const auto found = mUnitsAmbiguous.FindIt(type);
       return found ? found.GetValue().GetCount() : 0;
    }
 
+   /// Rebuild the type mask from the trait and unit maps                     
+   /// Maps are small, so this is cheaper than tracking individual counts     
+   void Thing::UpdateTypeMask() {
+      mTypeMask.Reset();
+      for (auto pair : mTraits)
+         mTypeMask.Set(GetTypeIndex(pair.mKey));
+      for (auto pair : mUnitsAmbiguous)
+         mTypeMask.Set(GetTypeIndex(pair.mKey));
+   }
+
+   /// Get the mask of all trait and unit types in this Thing, for cheap      
+   /// filtering before searching                                             
+   ///   @return the type mask                                                
+   auto Thing::GetTypeMask() const noexcept -> const TypeMask& {
+      return mTypeMask;
+   }
+
    /// Check if all units in the hierarchy require a Refresh() call           
    ///   @return true if the thing is dirty                                   
    bool Thing::RequiresRefresh() const noexcept {
       return mRefreshRequired;
    }
 
+   /// Check if any Thing below this one requires a Refresh() call            
+   ///   @return true if there's a dirty Thing below                          
+   bool Thing::RequiresRefreshBelow() const noexcept {
+      return mRefreshBelow.load(::std::memory_order_relaxed);
+   }
+
    /// Get the current runtime                                                
    ///   @return the pointer to the runtime                                   
    auto Thing::GetRuntime() const noexcept -> const Pin<Ref<Runtime>>& {
@@ -524,8 +1405,19 @@ namespace Langulus::Entity
       if (mRuntime.IsLocked())
          return &*mRuntime;
 
+      // Move units to the new runtime's registry, and nest the new     
+      // runtime in the previous one                                    
+      const auto previous = mRuntime != nullptr ? &*mRuntime : nullptr;
+      UnregisterUnits(previous, this);
+      UnindexTraits(previous, this);
+      if (previous)
+         previous->ForgetChanges(this);
+
       mRuntime.Get().New(this);
       mRuntime.Lock();
+      mRuntime->Nest(previous);
+      RegisterUnits(&*mRuntime);
+      IndexTraits(&*mRuntime);
 
       // Dispatch the change to all children                            
       for (auto& child : mChildren)
@@ -10,8 +10,17 @@
 #include "Runtime.hpp"
 #include "Hierarchy.hpp"
 #include "Unit.hpp"
+#include "SmallMap.hpp"
+#include "BaseList.hpp"
+#include "Conversion.hpp"
+#include "TypeMask.hpp"
 #include <Flow/Verbs/Create.hpp>
 #include <Flow/Verbs/Select.hpp>
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 LANGULUS_DEFINE_TRAIT(Runtime,
    "Accesses the runtime of a hierarchy of Things");
@@ -23,8 +32,15 @@ namespace Langulus::Entity
 {
 
    using UnitList = TMany<A::Unit*>;
-   using UnitMap = TUnorderedMap<DMeta, TMany<A::Unit*>>;
-   using TraitMap = TUnorderedMap<TMeta, TraitList>;
+
+   /// Number of unit types and trait types a Thing keeps inline, before its  
+   /// maps overflow to hash maps. Units are registered by their type and all 
+   /// bases up to A::Unit, so four cover two or three typical units          
+   constexpr Count InlineUnitTypes = 4;
+   constexpr Count InlineTraitTypes = 4;
+
+   using UnitMap = TSmallMap<DMeta, TMany<A::Unit*>, InlineUnitTypes>;
+   using TraitMap = TSmallMap<TMeta, TraitList, InlineTraitTypes>;
 
 
    ///                                                                        
@@ -44,11 +60,13 @@ namespace Langulus::Entity
       LANGULUS(POOL_TACTIC) RTTI::PoolTactic::Type;
       LANGULUS_BASES(Resolvable);
       LANGULUS_VERBS(Verbs::Create, Verbs::Select);
+      friend class Prefab;
 
    protected:
       LANGULUS_API(ENTITY) void ResetRuntime(Runtime*);
       LANGULUS_API(ENTITY) void ResetFlow(Temporal*);
       LANGULUS_API(ENTITY) void Teardown();
+      LANGULUS_API(ENTITY) bool UpdateParallel(Time, Scheduler&);
 
       // The order of members is critical!                              
       // Runtime should be destroyed last, hence it is the first member 
@@ -63,17 +81,135 @@ namespace Langulus::Entity
       UnitMap mUnitsAmbiguous;
       // Traits                                                         
       TraitMap mTraits;
+      // Dense indices of all trait types and unit types/bases inside   
+      TypeMask mTypeMask;
       // Hierarchy requires an update                                   
       bool mRefreshRequired {};
+      // A Thing below requires an update. Atomic, because subtrees      
+      // that are updated in parallel mark their shared owners          
+      ::std::atomic<bool> mRefreshBelow {};
+      // Trait and unit types, that changed here since the last refresh 
+      TypeMask mChangedTypes;
       // The entity's parent                                            
       Ref<Thing> mOwner;
+      // Index of this Thing inside its owner's mChildren               
+      Offset mChildSlot {};
+      // Index of each unit inside mUnitsList, for O(1) membership      
+      ::std::unordered_map<const A::Unit*, Offset> mUnitSlots;
+      // Whether removing children and units may reorder the rest       
+      bool mUnorderedRemoval {};
+      // The prefab this Thing was made from, if it made all of it      
+      // Used to recycle the Thing for the same prefab                  
+      ::std::shared_ptr<const Prefab> mPrefab;
+      // Handle to this Thing, issued by the runtime on first request   
+      mutable ThingHandle mHandle;
+
+      // Children with a local textual name, indexed by that name, in   
+      // the order they appear in mChildren. Pointers don't keep the    
+      // children alive - mChildren does                                
+      TUnorderedMap<Text, TMany<Thing*>> mNameIndex;
+      // Number of children, that aren't indexed, but might still be    
+      // named by their units, or by a name that isn't text             
+      Count mUnindexedNames {};
+      // The name this Thing is indexed by in its owner's mNameIndex,   
+      // shared with the name trait it came from                        
+      Text mIndexedName;
+      // Whether this Thing is counted in owner's mUnindexedNames       
+      bool mUnindexedName {};
+
+      ///                                                                     
+      ///   Seek cache key                                                    
+      ///                                                                     
+      struct SeekKey {
+         LANGULUS(POD) true;
+
+         // The seeked unit type or trait type                          
+         const void* mMeta;
+         // The output type, when seeking values                        
+         const void* mOutput;
+         // The seek direction                                          
+         Offset mSeek;
+         // The match offset                                            
+         Offset mOffset;
+
+         NOD() Hash GetHash() const noexcept {
+            return HashBytes(this, static_cast<int>(sizeof(SeekKey)));
+         }
+
+         NOD() bool operator == (const SeekKey&) const noexcept = default;
+      };
+
+      ///                                                                     
+      ///   Seek cache entry                                                  
+      ///                                                                     
+      struct SeekHit {
+         LANGULUS(POD) true;
+
+         // The found unit, or the Thing that provided a trait/value    
+         // Stored as POD, so that the cache never references anything  
+         const void* mResult;
+      };
+
+      // Memoized upward seeks, valid as long as neither this Thing,    
+      // nor any of its owners changed after mSeekGeneration            
+      mutable TUnorderedMap<SeekKey, SeekHit> mSeekCache;
+      // The hierarchy generation the seek cache was last validated at  
+      mutable Count mSeekGeneration {};
+      // The hierarchy generation this Thing last changed at            
+      Count mChangedAt {};
+      // Incremented on any unit, trait or child change in any Thing    
+      LANGULUS_API(ENTITY) static ::std::atomic<Count> mHierarchyGeneration;
+
+      // Units that are able to handle a verb, indexed by the verb      
+      // Built lazily, and dropped whenever units change                
+      mutable TUnorderedMap<VMeta, UnitList> mHandlers;
+      // Incremented whenever units are added or removed, so that a     
+      // dispatch can tell if its handlers are still here               
+      Count mUnitChanges {};
+
+      void InvalidateSeeks() noexcept;
+      LANGULUS_API(ENTITY) void MarkDirty(Offset);
+      LANGULUS_API(ENTITY) void MarkDirty();
+      void MarkDirtyBelow() noexcept;
+      LANGULUS_API(ENTITY) void RemoveChildSlot(Offset);
+      LANGULUS_API(ENTITY) void RemoveUnitSlot(Offset);
+      NOD() LANGULUS_API(ENTITY) auto ReuseChild(const Many&, const ::std::shared_ptr<const Prefab>&) -> Ref<Thing>;
+      LANGULUS_API(ENTITY) void CreateFromPrefab(Verb&, const ::std::shared_ptr<const Prefab>&);
+      LANGULUS_API(ENTITY) void ReleaseHandle(Runtime*);
+      LANGULUS_API(ENTITY) void ReleaseUnitHandle(A::Unit*);
+      LANGULUS_API(ENTITY) void NotifyChange(const Change&);
+      void RefreshSubtree(const TypeMask*);
+      LANGULUS_API(ENTITY) void UpdateTypeMask();
+      NOD() auto GetLocalName() const -> Token;
+      LANGULUS_API(ENTITY) void IndexChild(Thing*);
+      LANGULUS_API(ENTITY) void UnindexChild(Thing*);
+      LANGULUS_API(ENTITY) void ReindexName();
+      NOD() bool IsNamedIndirectly() const;
+      LANGULUS_API(ENTITY)
+      auto GetHandlers(VMeta) const -> UnitList;
+      auto FindSeek(const SeekKey&) const -> const SeekHit*;
+      void CacheSeek(const SeekKey&, const void*) const;
+      template<class D>
+      bool ReadValue(TMeta, D&, Index) const;
+
+      template<Seek, class F>
+      bool VisitUnits(DMeta, F&, Count&);
+      NOD() LANGULUS_API(ENTITY)
+      auto GatherRegisteredOwners(DMeta) const -> TMany<Thing*>;
+      template<Seek, class F>
+      bool VisitTraits(TMeta, F&, Count&);
 
       template<Seek = Seek::HereAndAbove>
       NOD() Many CreateData(const Construct&);
+      template<Seek = Seek::HereAndAbove>
+      NOD() Many ProduceData(const Construct&, DMeta);
 
       template<class T>
       void CreateInner(Verb&, const T&);
 
+      void CloneFrom(const Thing&);
+      void CloneFrom(const Thing&, TUnorderedMap<const A::Unit*, A::Unit*>&);
+
    public:
       LANGULUS_API(ENTITY) Thing();
       LANGULUS_API(ENTITY) Thing(Describe&&);
@@ -93,6 +229,8 @@ namespace Langulus::Entity
 
       NOD() LANGULUS_API(ENTITY)
       bool RequiresRefresh() const noexcept;
+      NOD() LANGULUS_API(ENTITY)
+      bool RequiresRefreshBelow() const noexcept;
 
       NOD() LANGULUS_API(ENTITY)
       auto GetRuntime() const noexcept -> const Pin<Ref<Runtime>>&;
@@ -115,6 +253,8 @@ namespace Langulus::Entity
       LANGULUS_API(ENTITY) bool Update(Time);
       LANGULUS_API(ENTITY) void Refresh(bool force = false);
       LANGULUS_API(ENTITY) void Reset();
+      LANGULUS_API(ENTITY) void Clear();
+      LANGULUS_API(ENTITY) void Recycle();
 
       NOD() LANGULUS_API(ENTITY)
       bool operator == (const Thing&) const;
@@ -161,9 +301,44 @@ namespace Langulus::Entity
       NOD() LANGULUS_API(ENTITY)
       auto GetNamedChild(const Token&, Index = 0) const -> const Thing*;
 
+      NOD() LANGULUS_API(ENTITY)
+      auto FindByPath(const Token&) -> Thing*;
+      NOD() LANGULUS_API(ENTITY)
+      auto FindByPath(const Token&) const -> const Thing*;
+
+      NOD() LANGULUS_API(ENTITY)
+      bool IsDescendantOf(const Thing*) const noexcept;
+      NOD() LANGULUS_API(ENTITY)
+      bool HasChild(const Thing*) const noexcept;
+
+      NOD() LANGULUS_API(ENTITY)
+      auto GetHandle() const -> ThingHandle;
+      NOD() LANGULUS_API(ENTITY)
+      auto GatherChildHandles() const -> TMany<ThingHandle>;
+
+      LANGULUS_API(ENTITY)
+      void SetUnorderedRemoval(bool) noexcept;
+      NOD() LANGULUS_API(ENTITY)
+      bool IsUnorderedRemoval() const noexcept;
+
+      NOD() LANGULUS_API(ENTITY)
+      auto CloneN(Count, Thing* = nullptr) const -> Hierarchy;
+
+      LANGULUS_API(ENTITY)
+      void Reserve(Count, Count = 0);
+
       LANGULUS_API(ENTITY)
       void DumpHierarchy() const;
 
+      #if LANGULUS_FEATURE(MANAGED_REFLECTION)
+         static constexpr uint32_t SnapshotVersion = 2;
+
+         NOD() LANGULUS_API(ENTITY)
+         auto Save() const -> Bytes;
+         LANGULUS_API(ENTITY)
+         void Load(const Bytes&);
+      #endif
+
    public:
       ///                                                                     
       ///   Unit management                                                   
@@ -224,12 +399,17 @@ namespace Langulus::Entity
    private:
       LANGULUS_API(ENTITY) void AddUnitBases(A::Unit*, DMeta);
       LANGULUS_API(ENTITY) void RemoveUnitBases(A::Unit*, DMeta);
+      LANGULUS_API(ENTITY) void RegisterUnits(Runtime*);
+      LANGULUS_API(ENTITY) void UnregisterUnits(Runtime*, Thing*);
+      LANGULUS_API(ENTITY) void IndexTraits(Runtime*);
+      LANGULUS_API(ENTITY) void UnindexTraits(Runtime*, Thing*);
 
    public:
       ///                                                                     
       ///   Trait management                                                  
       ///                                                                     
       LANGULUS_API(ENTITY) auto AddTrait(Trait) -> Trait*;
+      LANGULUS_API(ENTITY) auto SetTrait(Trait) -> Trait*;
 
       LANGULUS_API(ENTITY) Count RemoveTrait(TMeta);
       LANGULUS_API(ENTITY) Count RemoveTrait(Trait);
@@ -242,6 +422,8 @@ namespace Langulus::Entity
       NOD() LANGULUS_API(ENTITY)
       auto GetTraits() const noexcept -> const TraitMap&;
       NOD() LANGULUS_API(ENTITY)
+      auto GetTypeMask() const noexcept -> const TypeMask&;
+      NOD() LANGULUS_API(ENTITY)
       auto GetTrait(TMeta, Index = 0) const -> Trait;
       NOD() LANGULUS_API(ENTITY)
       auto GetTrait(TMeta, Index = 0) -> Trait;
@@ -312,6 +494,15 @@ namespace Langulus::Entity
 
       template<Seek = Seek::HereAndAbove>
       auto GatherTraits(TMeta) -> TraitList;
+      template<Seek = Seek::HereAndAbove>
+      auto GatherUnitHandles(DMeta) -> TMany<UnitHandle>;
+
+      template<Seek = Seek::HereAndAbove, class F>
+      auto ForEachUnit(DMeta, F&&) -> Count;
+      template<CT::Unit, Seek = Seek::HereAndAbove, class F>
+      auto ForEachUnit(F&&) -> Count;
+      template<Seek = Seek::HereAndAbove, class F>
+      auto ForEachTrait(TMeta, F&&) -> Count;
 
       template<CT::Data D, Seek = Seek::HereAndAbove>
       auto GatherValues() const -> TMany<D>;
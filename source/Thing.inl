@@ -7,6 +7,7 @@
 ///                                                                           
 #pragma once
 #include "Thing.hpp"
+#include "SmallMap.inl"
 #include "Thing-Gather.inl"
 #include "Thing-Seek.inl"
 
@@ -37,6 +38,22 @@ namespace Langulus::Entity
       ENTITY_VERBOSE_SELF_TAB(
          "Producing child (at ", GetReferences(), " references): ");
       Ref<Thing> newThing;
+      if constexpr (sizeof...(T) > 0) {
+         if (mRuntime != nullptr and mRuntime->GetThingPool()) {
+            // Reuse a recycled Thing, made from the same descriptor,   
+            // or make a new one from the same prefab, compiled once    
+            Many descriptor {Forward<T>(arguments)...};
+            const auto prefab = mRuntime->GetPrefab(descriptor);
+            newThing = ReuseChild(descriptor, prefab);
+            if (not newThing) {
+               newThing.New(this);
+               Verbs::Create creator {descriptor};
+               newThing->CreateFromPrefab(creator, prefab);
+            }
+            return Abandon(newThing);
+         }
+      }
+
       newThing.New(this, Many {Forward<T>(arguments)...});
       return Abandon(newThing);
    }
@@ -134,24 +151,44 @@ namespace Langulus::Entity
    template<bool TWOSIDED>
    Count Thing::AddChild(Thing* entity) {
       LANGULUS_ASSUME(UserAssumes, entity, "Bad entity pointer");
+      if (HasChild(entity))
+         return 0;
 
-      const auto added = mChildren.Merge(IndexBack, entity);
+      // A child knows its slot only in a single owner, so it has to    
+      // leave the previous owner first, while kept alive by this Ref   
+      Ref<Thing> reparented;
       if constexpr (TWOSIDED) {
-         if (added) {
-            if (entity->mOwner != this) {
-               if (entity->mOwner)
-                  entity->mOwner->RemoveChild<false>(entity);
-
-               entity->mOwner = this;
-               entity->mRefreshRequired = true;
-               ENTITY_VERBOSE_SELF(entity, "'s owner overwritten");
-            }
+         if (entity->mOwner and entity->mOwner != this) {
+            reparented = entity;
+            entity->mOwner->RemoveChild<false>(entity);
+         }
+      }
+
+      entity->mChildSlot = mChildren.GetCount();
+      mChildren << entity;
+      entity->InvalidateSeeks();
+      IndexChild(entity);
+      if (entity->mRefreshRequired
+      or  entity->mRefreshBelow.load(::std::memory_order_relaxed))
+         MarkDirtyBelow();
 
-            ENTITY_VERBOSE_SELF(entity, " added as child");
+      if constexpr (TWOSIDED) {
+         if (entity->mOwner != this) {
+            entity->mOwner = this;
+            entity->MarkDirty();
+            ENTITY_VERBOSE_SELF(entity, "'s owner overwritten");
          }
+
+         // Make sure the child uses the runtime of its new parent,     
+         // unless it has its own, in which case it becomes nested      
+         if (mRuntime != nullptr and entity->mRuntime != mRuntime)
+            entity->ResetRuntime(&*mRuntime);
+
+         ENTITY_VERBOSE_SELF(entity, " added as child");
       }
 
-      return added;
+      NotifyChange({Change::ChildAttached, this, nullptr, {}, entity});
+      return 1;
    }
       
    /// Remove a child that matches pointer                                    
@@ -163,21 +200,33 @@ namespace Langulus::Entity
    template<bool TWOSIDED>
    Count Thing::RemoveChild(Thing* entity) {
       LANGULUS_ASSUME(UserAssumes, entity, "Bad entity pointer");
-      
-      const auto removed = mChildren.Remove(entity);
-      if constexpr (TWOSIDED) {
-         if (removed) {
-            if (entity->mOwner == this) {
-               entity->mOwner = nullptr;
-               entity->mRefreshRequired = true;
-               ENTITY_VERBOSE_SELF(entity, "'s owner overwritten");
-            }
+      if (not HasChild(entity))
+         return 0;
+
+      // Report before removing, the child might get destroyed          
+      if (entity->mOwner == this)
+         NotifyChange({Change::ChildDetached, this, nullptr, {}, entity});
+
+      entity->InvalidateSeeks();
+      UnindexChild(entity);
 
-            ENTITY_VERBOSE_SELF(entity, " removed from children");
+      if constexpr (TWOSIDED) {
+         if (entity->mOwner == this) {
+            entity->mOwner = nullptr;
+            entity->MarkDirty();
+            ENTITY_VERBOSE_SELF(entity, "'s owner overwritten");
          }
+
+         // An own runtime is no longer nested in ours                  
+         if (entity->mRuntime.IsLocked())
+            entity->mRuntime->Nest(nullptr);
+
+         ENTITY_VERBOSE_SELF(entity, " removed from children");
       }
 
-      return removed;
+      // Dereference (and eventually destroy) the child                 
+      RemoveChildSlot(entity->mChildSlot);
+      return 1;
    }
 
    /// Execute verb in the hierarchy, searching for valid context in the      
@@ -229,8 +278,27 @@ namespace Langulus::Entity
       if (verb.IsDone())
          return verb;
 
-      // If verb is still not satisfied, dispatch to ALL units          
-      for (auto& unit : mUnitsList) {
+      // If verb is still not satisfied, dispatch to all units, that    
+      // are able to handle it. The list is held here, because units    
+      // might be added or removed by the handlers themselves           
+      const auto handlers = GetHandlers(verb.GetVerb());
+      if (handlers.GetCount() == 1) {
+         // A single handler works on the verb directly                 
+         try {
+            handlers[0]->Run(verb);
+         }
+         catch (...) {}
+         return verb;
+      }
+
+      // Multiple handlers work on copies, so that a failure leaves no  
+      // output                                                         
+      const auto changes = mUnitChanges;
+      for (auto unit : handlers) {
+         // Skip units, that were removed by a previous handler         
+         if (mUnitChanges != changes and not mUnitSlots.contains(unit))
+            continue;
+
          try {
             V local = verb;
             local.ShortCircuit(false);
@@ -253,17 +321,17 @@ namespace Langulus::Entity
    ///   @param unit - the unit instance to register                          
    ///   @param type - the type to register the unit as                       
    inline void Thing::AddUnitBases(A::Unit* unit, DMeta type) {
-      const auto found = mUnitsAmbiguous.FindIt(type);
-      if (found)
-         found.GetValue() << unit;
-      else
-         mUnitsAmbiguous.Insert(type, unit);
-
-      for (auto& base : type->mBases) {
-         if (base.mType->IsExact<A::Unit>())
-            break;
+      const auto& bases = GetBaseList<A::Unit>(type);
+      mUnitsAmbiguous.Append(bases, unit);
+      for (auto base : bases) {
+         const auto index = GetTypeIndex(base);
+         mTypeMask.Set(index);
+         mChangedTypes.Set(index);
+      }
 
-         AddUnitBases(unit, base.mType);
+      if (mRuntime != nullptr) {
+         for (auto base : bases)
+            mRuntime->RegisterUnit(base, unit, this);
       }
    }
 
@@ -271,18 +339,23 @@ namespace Langulus::Entity
    ///   @param unit - the unit instance to unregister                        
    ///   @param type - the type to unregister the unit as                     
    inline void Thing::RemoveUnitBases(A::Unit* unit, DMeta type) {
-      const auto found = mUnitsAmbiguous.FindIt(type);
-      if (found) {
-         auto& set = found.GetValue();
-         if (set.Remove(unit) and not set)
-            mUnitsAmbiguous.RemoveIt(found);
+      const auto& bases = GetBaseList<A::Unit>(type);
+      for (auto base : bases) {
+         const auto found = mUnitsAmbiguous.FindIt(base);
+         if (found) {
+            auto& set = found.GetValue();
+            if (set.Remove(unit) and not set)
+               mUnitsAmbiguous.RemoveIt(found);
+         }
+
+         mChangedTypes.Set(GetTypeIndex(base));
       }
 
-      for (auto& base : type->mBases) {
-         if (base.mType->IsExact<A::Unit>())
-            break;
+      UpdateTypeMask();
 
-         RemoveUnitBases(unit, base.mType);
+      if (mRuntime != nullptr) {
+         for (auto base : bases)
+            mRuntime->UnregisterUnit(base, unit, this);
       }
    }
 
@@ -297,11 +370,11 @@ namespace Langulus::Entity
    template<bool TWOSIDED>
    Count Thing::AddUnit(A::Unit* unit) {
       // Check if the unit instance is already registered here          
-      const auto meta = unit->GetType();
-      const auto found = mUnitsAmbiguous.FindIt(meta);
-      if (found and found.GetValue().Find(unit))
+      if (mUnitSlots.contains(unit))
          return 0;
 
+      const auto meta = unit->GetType();
+
       // We must guarantee, that no unit is coupled to entities with    
       // different runtimes!                                            
       for (const auto& owners : unit->mOwners) {
@@ -320,9 +393,18 @@ namespace Langulus::Entity
          #endif
       }
 
+      mUnitSlots[unit] = mUnitsList.GetCount();
       mUnitsList << unit;
       AddUnitBases(unit, meta);
-      mRefreshRequired = true;
+      mHandlers.Reset();
+      ++mUnitChanges;
+      if (not mIndexedName)
+         ReindexName();
+      MarkDirty(GetTypeIndex(meta));
+      InvalidateSeeks();
+      if (mRuntime != nullptr)
+         mRuntime->NotifyUnitsChanged(this);
+      NotifyChange({Change::UnitAdded, this, unit});
 
       ENTITY_VERBOSE(
          unit, " added as unit (now at ", GetReferences(), " references)");
@@ -337,24 +419,31 @@ namespace Langulus::Entity
    ///   @return 1 if unit has been removed                                   
    template<bool TWOSIDED>
    Count Thing::RemoveUnit(A::Unit* unit) {
-      const auto meta = unit->GetType();
-      const auto foundType = mUnitsAmbiguous.FindIt(meta);
-      if (not foundType)
-         return 0;
+      const auto found = mUnitSlots.find(unit);
+      if (found != mUnitSlots.end()) {
+         const auto slot = found->second;
+         const auto meta = unit->GetType();
 
-      const auto unitIndex = foundType.GetValue().Find(unit);
-      if (unitIndex) {
          // Decouple before unit is destroyed                           
          if constexpr (TWOSIDED)
             unit->mOwners.Remove(this);
+         ReleaseUnitHandle(unit);
 
          // Notify all other units about the environment change         
-         mRefreshRequired = true;
+         NotifyChange({Change::UnitRemoved, this, unit});
+         MarkDirty(GetTypeIndex(meta));
+         InvalidateSeeks();
          ENTITY_VERBOSE_SELF(unit, " removed from units");
 
          // Dereference (and eventually destroy) unit                   
          RemoveUnitBases(unit, meta);
-         mUnitsList.Remove(unit);
+         RemoveUnitSlot(slot);
+         mHandlers.Reset();
+         ++mUnitChanges;
+         if (not mIndexedName)
+            ReindexName();
+         if (mRuntime != nullptr)
+            mRuntime->NotifyUnitsChanged(this);
          return 1;
       }
 
@@ -378,22 +467,36 @@ namespace Langulus::Entity
                unit->mOwners.Remove(this);
          }
 
+         // Report before unregistering, like a single unit removal     
+         for (auto& unit : mUnitsList) {
+            NotifyChange({Change::UnitRemoved, this, unit});
+            ReleaseUnitHandle(unit);
+         }
+         UnregisterUnits(mRuntime != nullptr ? &*mRuntime : nullptr, this);
+
          mUnitsList.Reset();
+         mUnitSlots.clear();
          mUnitsAmbiguous.Reset();
-         mRefreshRequired = true;
+         UpdateTypeMask();
+         mHandlers.Reset();
+         ++mUnitChanges;
+         if (not mIndexedName)
+            ReindexName();
+         MarkDirty();
+         InvalidateSeeks();
          ENTITY_VERBOSE_SELF("All ", removed, " units were removed");
          return removed;
       }
       else {
          // Remove units of a specific type                             
          const auto meta = MetaOf<Decay<T>>();
-         const auto found = mUnitsAmbiguous.Find(meta);
+         const auto found = mUnitsAmbiguous.FindIt(meta);
          if (not found)
             return 0;
 
          // List intentionally shallow-copied, its memory will diverge  
          // upon RemoveUnit                                             
-         auto list = mUnitsAmbiguous.GetValue(found);
+         auto list = found.GetValue();
          Count removed {};
          for (auto& unit : list)
             removed += RemoveUnit(unit);
@@ -409,7 +512,8 @@ namespace Langulus::Entity
       return HasUnits(MetaOf<Decay<T>>());
    }
 
-   /// Get the list of units, in order of addition                            
+   /// Get the list of units, in order of addition, unless removal is         
+   /// unordered - see SetUnorderedRemoval                                    
    ///   @return a reference to the list of units                             
    LANGULUS(INLINED)
    auto Thing::GetUnits() const noexcept -> const UnitList& {
@@ -548,14 +652,26 @@ namespace Langulus::Entity
    ///   @tparam SEEK - what part of the hierarchy to use for the creation    
    ///   @param construct - instructions for the creation of the data         
    ///   @return created data                                                 
-   template<Seek SEEK>
+   template<Seek SEEK> LANGULUS(INLINED)
    Many Thing::CreateData(const Construct& construct) {
       LANGULUS_ASSUME(UserAssumes, construct.GetType(),
          "Invalid construct type");
 
       const auto type = construct.GetType();
-      const auto producer = type and type->mProducerRetriever
-         ? type->mProducerRetriever() : nullptr;
+      return ProduceData<SEEK>(construct, type and type->mProducerRetriever
+         ? type->mProducerRetriever() : nullptr);
+   }
+
+   /// Produce constructs (including units) from the hierarchy, with an       
+   /// already resolved producer                                              
+   ///   @attention assumes construct has a valid type                        
+   ///   @tparam SEEK - what part of the hierarchy to use for the creation    
+   ///   @param construct - instructions for the creation of the data         
+   ///   @param producer - the producer of the construct's type, if any       
+   ///   @return created data                                                 
+   template<Seek SEEK>
+   Many Thing::ProduceData(const Construct& construct, DMeta producer) {
+      const auto type = construct.GetType();
       Construct descriptor = construct;
 
       ENTITY_VERBOSE_SELF(
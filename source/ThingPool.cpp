@@ -0,0 +1,130 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Thing.hpp"
+#include "Thing.inl"
+
+
+namespace Langulus::Entity
+{
+
+   /// Create a pool                                                          
+   ///   @param capacity - the maximum number of parked Things per prefab     
+   ThingPool::ThingPool(Count capacity)
+      : mCapacity {capacity} {}
+
+   /// Destroying the pool destroys all parked Things                         
+   ThingPool::~ThingPool() = default;
+
+   /// Check if a Thing, made from a prefab, can be parked                    
+   ///   @param prefab - the prefab the Thing was made from                   
+   ///   @return true if the pool isn't full for that prefab                  
+   bool ThingPool::HasRoom(const Prefab* prefab) const {
+      ::std::scoped_lock lock {mMutex};
+      const auto found = mParked.find(prefab);
+      return found == mParked.end() ? mCapacity > 0
+         : found->second.size() < mCapacity;
+   }
+
+   /// Park a recycled Thing, unless the pool is full for its prefab          
+   ///   @attention the Thing should be cleared and detached by now           
+   ///   @param thing - the Thing to park                                     
+   ///   @param prefab - the prefab the Thing was made from                   
+   ///   @return true if the Thing was parked                                 
+   bool ThingPool::Park(Thing* thing, const Prefab* prefab) {
+      LANGULUS_ASSUME(DevAssumes, thing and prefab, "Invalid thing or prefab");
+      ::std::scoped_lock lock {mMutex};
+      auto& parked = mParked[prefab];
+      if (parked.size() >= mCapacity)
+         return false;
+
+      parked.emplace_back(thing);
+      ++mCount;
+      return true;
+   }
+
+   /// Take a parked Thing, that was made from a prefab                       
+   ///   @param prefab - the prefab                                           
+   ///   @return the Thing, or nothing if there's no such Thing parked        
+   auto ThingPool::Take(const Prefab* prefab) -> Ref<Thing> {
+      ::std::scoped_lock lock {mMutex};
+      const auto found = mParked.find(prefab);
+      if (found == mParked.end() or found->second.empty()) {
+         ++mMisses;
+         return {};
+      }
+
+      auto thing = ::std::move(found->second.back());
+      found->second.pop_back();
+      --mCount;
+      ++mHits;
+      return thing;
+   }
+
+   /// Destroy all parked Things, the counters are kept                       
+   void ThingPool::Clear() {
+      ::std::scoped_lock lock {mMutex};
+      mParked.clear();
+      mCount = 0;
+   }
+
+   /// Destroy all Things parked for a prefab, when the prefab is evicted     
+   /// from the cache, and no longer requested                                
+   ///   @param prefab - the prefab                                           
+   void ThingPool::Discard(const Prefab* prefab) {
+      ::std::scoped_lock lock {mMutex};
+      const auto found = mParked.find(prefab);
+      if (found == mParked.end())
+         return;
+
+      mCount -= found->second.size();
+      mParked.erase(found);
+   }
+
+   /// Change the maximum number of parked Things per prefab                  
+   /// Any parked Things above the new capacity are destroyed                 
+   ///   @param capacity - the new capacity                                   
+   void ThingPool::SetCapacity(Count capacity) {
+      ::std::scoped_lock lock {mMutex};
+      mCapacity = capacity;
+      for (auto& [prefab, parked] : mParked) {
+         if (parked.size() > capacity) {
+            mCount -= parked.size() - capacity;
+            parked.resize(capacity);
+         }
+      }
+   }
+
+   /// Get the maximum number of parked Things per prefab                     
+   ///   @return the capacity                                                 
+   Count ThingPool::GetCapacity() const {
+      ::std::scoped_lock lock {mMutex};
+      return mCapacity;
+   }
+
+   /// Get the number of parked Things, for all prefabs                       
+   ///   @return the number of parked Things                                  
+   Count ThingPool::GetCount() const {
+      ::std::scoped_lock lock {mMutex};
+      return mCount;
+   }
+
+   /// Get the number of requests, that reused a parked Thing                 
+   ///   @return the number of hits                                           
+   Count ThingPool::GetHits() const {
+      ::std::scoped_lock lock {mMutex};
+      return mHits;
+   }
+
+   /// Get the number of requests, that found no parked Thing                 
+   ///   @return the number of misses                                         
+   Count ThingPool::GetMisses() const {
+      ::std::scoped_lock lock {mMutex};
+      return mMisses;
+   }
+
+} // namespace Langulus::Entity
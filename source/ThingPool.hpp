@@ -0,0 +1,78 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Common.hpp"
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Langulus::Entity
+{
+
+   class Thing;
+   class Prefab;
+
+
+   ///                                                                        
+   ///   Thing pool                                                           
+   ///                                                                        
+   ///   Keeps recycled Things around, instead of destroying them, so that    
+   /// short-lived Things, that are spawned over and over from the same       
+   /// descriptor, are reused along with the memory of their containers.      
+   /// Things are parked by Thing::Recycle, already cleared and detached      
+   /// from their runtime, and are handed back by Thing::CreateChild, when    
+   /// a child is requested from the prefab they were made from. A pool is    
+   /// owned by a Runtime - see Runtime::SetThingPool.                        
+   ///                                                                        
+   class ThingPool final {
+      // Parked Things, indexed by the prefab they were made from       
+      // Each parked Thing keeps its prefab alive, so the key is valid  
+      ::std::unordered_map<const Prefab*, ::std::vector<Ref<Thing>>> mParked;
+      // Maximum number of parked Things per prefab                     
+      Count mCapacity;
+      // Number of parked Things, for all prefabs                       
+      Count mCount {};
+      // Number of requests, that reused a parked Thing                 
+      Count mHits {};
+      // Number of requests, that found no parked Thing                 
+      Count mMisses {};
+      // Guards the pool, Things may be created from worker threads     
+      mutable ::std::mutex mMutex;
+
+   public:
+      LANGULUS_API(ENTITY)  ThingPool(Count);
+      LANGULUS_API(ENTITY) ~ThingPool();
+
+      ThingPool(const ThingPool&) = delete;
+      ThingPool& operator = (const ThingPool&) = delete;
+
+      NOD() LANGULUS_API(ENTITY)
+      bool HasRoom(const Prefab*) const;
+      LANGULUS_API(ENTITY)
+      bool Park(Thing*, const Prefab*);
+      NOD() LANGULUS_API(ENTITY)
+      auto Take(const Prefab*) -> Ref<Thing>;
+
+      LANGULUS_API(ENTITY)
+      void Clear();
+      LANGULUS_API(ENTITY)
+      void Discard(const Prefab*);
+      LANGULUS_API(ENTITY)
+      void SetCapacity(Count);
+      NOD() LANGULUS_API(ENTITY)
+      Count GetCapacity() const;
+      NOD() LANGULUS_API(ENTITY)
+      Count GetCount() const;
+      NOD() LANGULUS_API(ENTITY)
+      Count GetHits() const;
+      NOD() LANGULUS_API(ENTITY)
+      Count GetMisses() const;
+   };
+
+} // namespace Langulus::Entity
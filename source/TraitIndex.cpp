@@ -0,0 +1,152 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Thing.hpp"
+#include "Thing.inl"
+#include "Conversion.hpp"
+#include <unordered_set>
+
+
+namespace Langulus::Entity
+{
+
+   /// Create an empty trait index                                            
+   ///   @param trait - the trait type to index                               
+   ///   @param kind - the kind of index                                      
+   TraitIndex::TraitIndex(TMeta trait, Kind kind)
+      : mTrait {trait}
+      , mKind  {kind} {}
+
+   /// Get the indexed trait type                                             
+   ///   @return the trait type                                               
+   auto TraitIndex::GetTrait() const noexcept -> TMeta {
+      return mTrait;
+   }
+
+   /// Get the kind of index                                                  
+   ///   @return the kind                                                     
+   auto TraitIndex::GetKind() const noexcept -> Kind {
+      return mKind;
+   }
+
+   /// Get the number of indexed traits                                       
+   ///   @return the number of traits                                         
+   Count TraitIndex::GetCount() const noexcept {
+      ::std::shared_lock lock {mMutex};
+      return mCount;
+   }
+
+   /// Index a trait value of a Thing                                         
+   /// Equal values in the same Thing are indexed once, and counted           
+   ///   @param value - the value of the trait                                
+   ///   @param thing - the Thing that has the trait                          
+   void TraitIndex::Insert(const Many& value, Thing* thing) {
+      Real number;
+      const bool ordered = mKind == Kind::Ordered and TryConvert(value, number);
+      const Offset hash = value.GetHash().mHash;
+
+      ::std::unique_lock lock {mMutex};
+      ++mCount;
+
+      bool found = false;
+      const auto [first, last] = mByHash.equal_range(hash);
+      for (auto it = first; it != last; ++it) {
+         if (it->second.mThing == thing and it->second.mValue == value) {
+            ++it->second.mCount;
+            found = true;
+            break;
+         }
+      }
+
+      if (not found)
+         mByHash.emplace(hash, Entry {thing, value, 1});
+      if (not ordered)
+         return;
+
+      const auto [low, high] = mByValue.equal_range(number);
+      for (auto it = low; it != high; ++it) {
+         if (it->second.mThing == thing) {
+            ++it->second.mCount;
+            return;
+         }
+      }
+
+      mByValue.emplace(number, OrderedEntry {thing, 1});
+   }
+
+   /// Remove a single indexed trait value of a Thing                         
+   ///   @param value - the value of the trait, as it was indexed             
+   ///   @param thing - the Thing that has the trait                          
+   void TraitIndex::Remove(const Many& value, Thing* thing) {
+      Real number;
+      const bool ordered = mKind == Kind::Ordered and TryConvert(value, number);
+      const Offset hash = value.GetHash().mHash;
+
+      ::std::unique_lock lock {mMutex};
+      const auto [first, last] = mByHash.equal_range(hash);
+      for (auto it = first; it != last; ++it) {
+         if (it->second.mThing == thing and it->second.mValue == value) {
+            if (not --it->second.mCount)
+               mByHash.erase(it);
+            --mCount;
+            break;
+         }
+      }
+
+      if (not ordered)
+         return;
+
+      const auto [low, high] = mByValue.equal_range(number);
+      for (auto it = low; it != high; ++it) {
+         if (it->second.mThing == thing) {
+            if (not --it->second.mCount)
+               mByValue.erase(it);
+            break;
+         }
+      }
+   }
+
+   /// Find all Things, that have a trait with the given value                
+   ///   @param value - the value to search for                               
+   ///   @return the Things, each once, in no particular order                
+   auto TraitIndex::Find(const Many& value) const -> TMany<Thing*> {
+      TMany<Thing*> result;
+      const Offset hash = value.GetHash().mHash;
+
+      ::std::shared_lock lock {mMutex};
+      const auto [first, last] = mByHash.equal_range(hash);
+      for (auto it = first; it != last; ++it) {
+         // Hashes might collide, so compare with the indexed value     
+         if (it->second.mValue == value)
+            result << it->second.mThing;
+      }
+
+      return Abandon(result);
+   }
+
+   /// Find all Things, that have a trait in the range [min; max]             
+   ///   @attention only available for ordered indexes                        
+   ///   @param min - the smallest value                                      
+   ///   @param max - the largest value                                       
+   ///   @return the Things, each once, sorted by their smallest value        
+   auto TraitIndex::FindRange(Real min, Real max) const -> TMany<Thing*> {
+      LANGULUS_ASSERT(mKind == Kind::Ordered, Access,
+         "Range lookups require an ordered index");
+
+      TMany<Thing*> result;
+      ::std::unordered_set<const Thing*> visited;
+
+      ::std::shared_lock lock {mMutex};
+      const auto last = mByValue.upper_bound(max);
+      for (auto it = mByValue.lower_bound(min); it != last; ++it) {
+         if (visited.insert(it->second.mThing).second)
+            result << it->second.mThing;
+      }
+      return Abandon(result);
+   }
+
+} // namespace Langulus::Entity
@@ -0,0 +1,93 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Common.hpp"
+#include <map>
+#include <shared_mutex>
+#include <unordered_map>
+
+
+namespace Langulus::Entity
+{
+
+   class Thing;
+   class Runtime;
+
+
+   ///                                                                        
+   ///   Trait index                                                          
+   ///                                                                        
+   ///   Maps the values of one trait type to the Things, that have it, for   
+   /// all Things in a runtime. Hash indexes find Things by equal value,      
+   /// ordered indexes also find them by a numeric range. Indexes are owned   
+   /// by the Runtime, and are maintained incrementally, whenever a trait of  
+   /// their type is added, removed or changed, so searching doesn't walk     
+   /// the hierarchy.                                                         
+   ///                                                                        
+   class TraitIndex final {
+      friend class Runtime;
+
+   public:
+      enum class Kind : uint8_t {
+         // Only equality lookups                                       
+         Hash,
+         // Equality and range lookups, for values that convert to Real 
+         Ordered
+      };
+
+   private:
+      /// A distinct trait value in a Thing                                   
+      struct Entry {
+         Thing* mThing;
+         // The indexed value, shared with the trait                    
+         Many mValue;
+         // Number of traits in the Thing, that have this value         
+         Count mCount;
+      };
+
+      /// A distinct numeric trait value in a Thing                           
+      struct OrderedEntry {
+         Thing* mThing;
+         // Number of traits in the Thing, that have this value         
+         Count mCount;
+      };
+
+      // The indexed trait type                                         
+      TMeta mTrait;
+      // The kind of index                                              
+      Kind mKind;
+      // Things, indexed by the hash of the trait value                 
+      // A Thing appears once for each distinct value it has            
+      ::std::unordered_multimap<Offset, Entry> mByHash;
+      // Things, indexed by the trait value as Real, if ordered         
+      ::std::multimap<Real, OrderedEntry> mByValue;
+      // Number of indexed traits                                       
+      Count mCount {};
+      // Guards the index, traits may change from worker threads        
+      mutable ::std::shared_mutex mMutex;
+
+      void Insert(const Many&, Thing*);
+      void Remove(const Many&, Thing*);
+
+   public:
+      TraitIndex(TMeta, Kind);
+
+      NOD() LANGULUS_API(ENTITY)
+      auto GetTrait() const noexcept -> TMeta;
+      NOD() LANGULUS_API(ENTITY)
+      auto GetKind() const noexcept -> Kind;
+      NOD() LANGULUS_API(ENTITY)
+      Count GetCount() const noexcept;
+
+      NOD() LANGULUS_API(ENTITY)
+      auto Find(const Many&) const -> TMany<Thing*>;
+      NOD() LANGULUS_API(ENTITY)
+      auto FindRange(Real, Real) const -> TMany<Thing*>;
+   };
+
+} // namespace Langulus::Entity
@@ -0,0 +1,81 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "TypeMask.hpp"
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+
+namespace Langulus::Entity
+{
+
+   /// Dense indices, assigned to reflected definitions                       
+   static ::std::unordered_map<const void*, Offset> gTypeIndices;
+   static ::std::mutex gTypeIndicesMutex;
+
+   /// A slot in the lock-free index cache. The definition is published       
+   /// only after the index is written, and neither ever changes afterwards   
+   struct TypeIndexSlot {
+      ::std::atomic<const void*> mMeta {};
+      Offset mIndex {};
+   };
+
+   /// Lock-free cache in front of gTypeIndices, an open addressed table      
+   /// indexed by definition address. Definitions, that don't fit in their    
+   /// probe window, are looked up in gTypeIndices instead                    
+   static constexpr Offset TypeIndexCacheSize = 4096;
+   static constexpr Offset TypeIndexProbes = 8;
+   static TypeIndexSlot gTypeIndexCache[TypeIndexCacheSize];
+
+   /// Get the first cache slot, where a definition might be                  
+   ///   @param meta - the type or trait definition                           
+   ///   @return the slot index                                               
+   static Offset GetTypeIndexSlot(const void* meta) noexcept {
+      // Definitions are aligned, so the lowest bits carry no entropy   
+      const auto address = reinterpret_cast<uintptr_t>(meta);
+      return ((address >> 4) ^ (address >> 16)) % TypeIndexCacheSize;
+   }
+
+   /// Get the dense index of a reflected type or trait, assigning the next   
+   /// free one, if the definition hasn't been indexed yet. Indices aren't    
+   /// recycled when types are unloaded, because Things might still refer     
+   /// to them in their masks. Lookups of indexed definitions take no lock    
+   ///   @param meta - the type or trait definition                           
+   ///   @return the index                                                    
+   auto GetTypeIndex(const void* meta) -> Offset {
+      const auto first = GetTypeIndexSlot(meta);
+      for (Offset i = 0; i < TypeIndexProbes; ++i) {
+         const auto& slot = gTypeIndexCache[(first + i) % TypeIndexCacheSize];
+         const auto cached = slot.mMeta.load(::std::memory_order_acquire);
+         if (cached == meta)
+            return slot.mIndex;
+         if (not cached)
+            break;
+      }
+
+      ::std::scoped_lock lock {gTypeIndicesMutex};
+      const auto [found, inserted] = gTypeIndices
+         .try_emplace(meta, gTypeIndices.size());
+      if (not inserted)
+         return found->second;
+
+      // Publish the new index in the first free slot of the window     
+      for (Offset i = 0; i < TypeIndexProbes; ++i) {
+         auto& slot = gTypeIndexCache[(first + i) % TypeIndexCacheSize];
+         if (slot.mMeta.load(::std::memory_order_relaxed))
+            continue;
+
+         slot.mIndex = found->second;
+         slot.mMeta.store(meta, ::std::memory_order_release);
+         break;
+      }
+
+      return found->second;
+   }
+
+} // namespace Langulus::Entity
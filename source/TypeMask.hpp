@@ -0,0 +1,137 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Common.hpp"
+
+
+namespace Langulus::Entity
+{
+
+   NOD() LANGULUS_API(ENTITY)
+   auto GetTypeIndex(const void*) -> Offset;
+
+   /// Get the dense index of a reflected type                                
+   /// Indices are assigned on first request, in order, and never reused      
+   ///   @param meta - the type definition                                    
+   ///   @return the index                                                    
+   NOD() LANGULUS(INLINED)
+   auto GetTypeIndex(DMeta meta) -> Offset {
+      return GetTypeIndex(static_cast<const void*>(&*meta));
+   }
+
+   /// Get the dense index of a reflected trait                               
+   ///   @param meta - the trait definition                                   
+   ///   @return the index                                                    
+   NOD() LANGULUS(INLINED)
+   auto GetTypeIndex(TMeta meta) -> Offset {
+      return GetTypeIndex(static_cast<const void*>(&*meta));
+   }
+
+   /// Get the dense index of a static type or trait, resolved only once      
+   ///   @tparam T - the type or trait                                        
+   ///   @return the index                                                    
+   template<class T> NOD() LANGULUS(INLINED)
+   auto GetTypeIndex() -> Offset {
+      static const Offset index = GetTypeIndex(MetaOf<Decay<T>>());
+      return index;
+   }
+
+
+   ///                                                                        
+   ///   Type mask                                                            
+   ///                                                                        
+   ///   A fixed-size bitset over dense type indices, that tells whether a    
+   /// Thing may contain a trait or unit type, without any hashing. Indices   
+   /// beyond the capacity are folded onto it, so each bit is shared by a     
+   /// few types at most - the mask never reports a false negative, and       
+   /// reports false positives only between types, that share a bit.          
+   ///                                                                        
+   class TypeMask {
+   public:
+      static constexpr Offset Capacity = 256;
+
+   private:
+      static constexpr Offset WordBits = sizeof(uint64_t) * 8;
+      static constexpr Offset WordCount = Capacity / WordBits;
+      uint64_t mBits[WordCount] {};
+
+      /// Get the word a type index is in                                     
+      ///   @param index - the dense type index                               
+      ///   @return the word index                                            
+      NOD() static constexpr Offset Word(Offset index) noexcept {
+         return (index % Capacity) / WordBits;
+      }
+
+      /// Get the bit of a type index inside its word                         
+      ///   @param index - the dense type index                               
+      ///   @return the bit                                                   
+      NOD() static constexpr uint64_t Bit(Offset index) noexcept {
+         return uint64_t {1} << (index % WordBits);
+      }
+
+   public:
+      /// Mark a type index as contained                                      
+      ///   @param index - the dense type index                               
+      constexpr void Set(Offset index) noexcept {
+         mBits[Word(index)] |= Bit(index);
+      }
+
+      /// Check if a type index might be contained                            
+      ///   @param index - the dense type index                               
+      ///   @return false only if the type is definitely not contained        
+      NOD() constexpr bool MayContain(Offset index) const noexcept {
+         return mBits[Word(index)] & Bit(index);
+      }
+
+      /// Check if all types in another mask might be contained               
+      ///   @param other - the mask of required types                         
+      ///   @return false only if any of the types is definitely missing      
+      NOD() constexpr bool MayContainAll(const TypeMask& other) const noexcept {
+         for (Offset i = 0; i < WordCount; ++i) {
+            if ((mBits[i] & other.mBits[i]) != other.mBits[i])
+               return false;
+         }
+         return true;
+      }
+
+      /// Check if any of the types in another mask might be contained        
+      ///   @param other - the mask of types                                  
+      ///   @return false only if none of the types are contained             
+      NOD() constexpr bool Intersects(const TypeMask& other) const noexcept {
+         for (Offset i = 0; i < WordCount; ++i) {
+            if (mBits[i] & other.mBits[i])
+               return true;
+         }
+         return false;
+      }
+
+      /// Mark all types in another mask as contained                         
+      ///   @param other - the mask of types                                  
+      constexpr void Merge(const TypeMask& other) noexcept {
+         for (Offset i = 0; i < WordCount; ++i)
+            mBits[i] |= other.mBits[i];
+      }
+
+      /// Mark all possible types as contained                                
+      constexpr void SetAll() noexcept {
+         for (auto& word : mBits)
+            word = ~uint64_t {0};
+      }
+
+      NOD() constexpr bool IsEmpty() const noexcept {
+         return *this == TypeMask {};
+      }
+
+      constexpr void Reset() noexcept {
+         *this = {};
+      }
+
+      NOD() constexpr bool operator == (const TypeMask&) const noexcept = default;
+   };
+
+} // namespace Langulus::Entity
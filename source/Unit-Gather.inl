@@ -19,6 +19,7 @@ namespace Langulus::A
    ///   @return the gathered units that match the type                       
    template<Seek SEEK> LANGULUS(INLINED)
    TMany<Unit*> Unit::GatherUnits(DMeta meta) {
+      RecordDependency(meta);
       return mOwners.template GatherUnits<SEEK>(meta);
    }
    
@@ -28,6 +29,7 @@ namespace Langulus::A
    ///   @return the gathered traits that match the type                      
    template<Seek SEEK> LANGULUS(INLINED)
    TraitList Unit::GatherTraits(TMeta trait) {
+      RecordDependency(trait);
       return mOwners.template GatherTraits<SEEK>(trait);
    }
 
@@ -37,6 +39,7 @@ namespace Langulus::A
    ///   @return the gathered values                                          
    template<CT::Data D, Seek SEEK> LANGULUS(INLINED)
    TMany<D> Unit::GatherValues() const {
+      RecordDependency(TMeta {});
       return mOwners.template GatherValues<SEEK, D>();
    }
 
@@ -20,6 +20,7 @@ namespace Langulus::A
    ///   @return the found unit, or nullptr if no such unit was found         
    template<Seek SEEK> LANGULUS(INLINED)
    auto Unit::SeekUnit(DMeta meta, Index offset) -> Unit* {
+      RecordDependency(meta);
       return mOwners.template SeekUnit<SEEK>(meta, offset);
    }
 
@@ -31,6 +32,7 @@ namespace Langulus::A
    ///   @return the unit if found, or nullptr otherwise                      
    template<Seek SEEK> LANGULUS(INLINED)
    auto Unit::SeekUnitAux(const Many& aux, DMeta meta, Index offset) -> Unit* {
+      RecordDependency(meta);
       return mOwners.template SeekUnitAux<SEEK>(aux, meta, offset);
    }
       
@@ -42,6 +44,7 @@ namespace Langulus::A
    ///   @return the unit if found, or nullptr otherwise                      
    template<Seek SEEK> LANGULUS(INLINED)
    auto Unit::SeekUnitExt(DMeta type, const Many& ext, Index offset) -> Unit* {
+      RecordDependency(type);
       return mOwners.template SeekUnitExt<SEEK>(type, ext, offset);
    }
 
@@ -55,6 +58,7 @@ namespace Langulus::A
    ///   @return a pointer to the found unit, or nullptr if not found         
    template<Seek SEEK> LANGULUS(INLINED)
    auto Unit::SeekUnitAuxExt(DMeta type, const Many& aux, const Many& ext, Index offset) -> Unit* {
+      RecordDependency(type);
       return mOwners.template SeekUnitAuxExt<SEEK>(type, aux, ext, offset);
    }
 
@@ -65,6 +69,7 @@ namespace Langulus::A
    ///   @return the trait, which is not empty, if trait was found            
    template<Seek SEEK> LANGULUS(INLINED)
    auto Unit::SeekTrait(TMeta meta, Index offset) -> Langulus::Trait {
+      RecordDependency(meta);
       return mOwners.template SeekTrait<SEEK>(meta, offset);
    }
    
@@ -76,6 +81,7 @@ namespace Langulus::A
    ///   @return the trait, which is not empty, if trait was found            
    template<Seek SEEK> LANGULUS(INLINED)
    auto Unit::SeekTraitAux(const Many& aux, TMeta meta, Index offset) -> Langulus::Trait {
+      RecordDependency(meta);
       return mOwners.template SeekTraitAux<SEEK>(aux, meta, offset);
    }
     
@@ -89,6 +95,7 @@ namespace Langulus::A
    ///   @return true if output was rewritten                                 
    template<Seek SEEK> LANGULUS(INLINED)
    bool Unit::SeekValue(TMeta meta, CT::Data auto& output, Index offset) const {
+      RecordDependency(meta);
       return mOwners.template SeekValue<SEEK>(meta, output, offset);
    }
   
@@ -104,6 +111,7 @@ namespace Langulus::A
    ///   @return the trait, which is not empty, if trait was found            
    template<Seek SEEK> LANGULUS(INLINED)
    bool Unit::SeekValueAux(TMeta meta, const Many& aux, CT::Data auto& output, Index offset) const {
+      RecordDependency(meta);
       return mOwners.template SeekValueAux<SEEK>(meta, aux, output, offset);
    }
 
@@ -79,6 +79,25 @@ auto Unit::GetRuntime() const noexcept -> Runtime* {
    return &*mOwners[0]->GetRuntime();
 }
 
+/// Get a handle to the unit, issued by the runtime of its owners on first    
+/// request. The handle stays valid, until the unit loses all owners          
+///   @return the handle, or an invalid handle if there's no runtime          
+auto Unit::GetHandle() const -> Entity::UnitHandle {
+   if (not mHandle and mOwners) {
+      const auto runtime = GetRuntime();
+      if (runtime)
+         mHandle = runtime->IssueHandle(const_cast<Unit*>(this));
+   }
+   return mHandle;
+}
+
+/// Get the trait and unit types, that the unit sought since the start of     
+/// its last refresh. Only changes of these types refresh the unit again      
+///   @return the type mask                                                   
+auto Unit::GetDependencies() const noexcept -> const Entity::TypeMask& {
+   return mDependencies;
+}
+
 /// Couple the component with an entity, extracted from a descriptor's        
 /// Traits::Parent, if any was defined (always two-sided)                     
 /// This will call refresh to all units in that entity on next tick           
@@ -7,6 +7,8 @@
 ///                                                                           
 #pragma once
 #include "Hierarchy.hpp"
+#include "TypeMask.hpp"
+#include "Handle.hpp"
 
 
 namespace Langulus::A
@@ -50,6 +52,24 @@ namespace Langulus::A
          Hierarchy mOwners;
       #endif
 
+      // Trait and unit types, that the unit sought through its seek    
+      // interface since the start of its last refresh                  
+      mutable Entity::TypeMask mDependencies;
+      // Whether the unit was ever refreshed, and mDependencies is known
+      bool mDependenciesKnown {};
+      // Handle to this unit, issued by the runtime on first request    
+      mutable Entity::UnitHandle mHandle;
+
+      /// Remember that the unit depends on a type, so that it's refreshed    
+      /// only when that type changes - see Thing::Refresh                    
+      ///   @param meta - the sought trait or unit type, or nullptr for any   
+      void RecordDependency(const auto& meta) const {
+         if (meta)
+            mDependencies.Set(Entity::GetTypeIndex(meta));
+         else
+            mDependencies.SetAll();
+      }
+
    public:
       Unit() noexcept : Resolvable {this} {}
       Unit(const Unit&) = delete;
@@ -64,6 +84,8 @@ namespace Langulus::A
       virtual void Refresh();
 
       auto GetRuntime() const noexcept -> Runtime*;
+      auto GetHandle() const -> Entity::UnitHandle;
+      auto GetDependencies() const noexcept -> const Entity::TypeMask&;
       auto GetOwners() const noexcept -> const Hierarchy&;
       bool CompareDescriptor(const Many&) const;
       
@@ -29,7 +29,12 @@ public:
       Logger::Verbose(this, ": destroying...");
    }
 
-   void Refresh() {}
+   // Number of times the unit was refreshed                            
+   Count mRefreshes {};
+
+   void Refresh() {
+      ++mRefreshes;
+   }
 };
 
 /// A unit implementation for testing                                         
@@ -10,4 +10,718 @@
 
 SCENARIO("Testing external modules", "[module]") {
 
-}
\ No newline at end of file
+}
+
+SCENARIO("Ordering module updates by their declared dependencies", "[module]") {
+   static Allocator::State memoryState;
+   using Info = A::Module::Info;
+   using Dependencies = A::Module::Dependencies;
+   using Entity::ModuleGraph;
+
+   // Get the order of entries in the graph                             
+   const auto order = [](const ModuleGraph& graph) {
+      ::std::vector<Offset> result;
+      for (auto& node : graph.GetNodes())
+         result.push_back(node.mEntry);
+      return result;
+   };
+
+   GIVEN("A chain of dependencies, instantiated in reverse") {
+      // A updates before B, B before C, and C conflicts with A         
+      const Info a {0, "A", "", "", {}};
+      const Info b {0, "B", "", "", {}};
+      const Info c {0, "C", "", "", {}};
+      const Dependencies aDeps {"", nullptr};
+      const Dependencies bDeps {"A", nullptr};
+      const Dependencies cDeps {"B", "A"};
+
+      WHEN("The graph is built") {
+         ModuleGraph graph;
+         graph.Build({
+            {nullptr, 0, &c, &cDeps},
+            {nullptr, 0, &b, &bDeps},
+            {nullptr, 0, &a, &aDeps}
+         });
+
+         THEN("The conflict follows the transitive dependency") {
+            REQUIRE(not graph.IsCyclic());
+            REQUIRE(not graph.IsConcurrent());
+            REQUIRE(order(graph) == ::std::vector<Offset> {2, 1, 0});
+         }
+      }
+   }
+
+   GIVEN("Independent modules") {
+      const Info x {0, "X", "", "", {}};
+      const Info y {0, "Y", "", "", {}};
+      const Info z {0, "Z", "", "", {}};
+      const Dependencies xDeps {"", nullptr};
+      const Dependencies yDeps {"", nullptr};
+      const Dependencies zDeps {"", "X"};
+
+      WHEN("The graph is built") {
+         ModuleGraph graph;
+         graph.Build({{nullptr, 0, &x, &xDeps}, {nullptr, 0, &y, &yDeps}});
+
+         THEN("They can update concurrently") {
+            REQUIRE(not graph.IsCyclic());
+            REQUIRE(graph.IsConcurrent());
+            REQUIRE(graph.GetNodes().size() == 2);
+            REQUIRE(graph.GetNodes()[0].mPredecessors == 0);
+            REQUIRE(graph.GetNodes()[1].mPredecessors == 0);
+         }
+      }
+
+      WHEN("One of them conflicts with another") {
+         ModuleGraph graph;
+         graph.Build({{nullptr, 0, &z, &zDeps}, {nullptr, 0, &x, &xDeps}});
+
+         THEN("They are serialized in instantiation order") {
+            REQUIRE(not graph.IsCyclic());
+            REQUIRE(not graph.IsConcurrent());
+            REQUIRE(order(graph) == ::std::vector<Offset> {0, 1});
+         }
+      }
+   }
+
+   GIVEN("Modules, that don't export dependencies") {
+      const Info low  {1, "Low",  "", "", {}};
+      const Info high {2, "High", "", "", {}};
+
+      WHEN("The graph is built") {
+         ModuleGraph graph;
+         graph.Build({{nullptr, 1, &low}, {nullptr, 2, &high}});
+
+         THEN("They keep their priority order") {
+            REQUIRE(not graph.IsConcurrent());
+            REQUIRE(order(graph) == ::std::vector<Offset> {0, 1});
+         }
+      }
+   }
+
+   GIVEN("Cyclic dependencies") {
+      const Info p {0, "P", "", "", {}};
+      const Info q {0, "Q", "", "", {}};
+      const Info r {0, "R", "", "", {}};
+      const Dependencies pDeps {"Q", nullptr};
+      const Dependencies qDeps {"P", nullptr};
+      const Dependencies rDeps {"", nullptr};
+
+      WHEN("The graph is built") {
+         ModuleGraph graph;
+         graph.Build({
+            {nullptr, 0, &p, &pDeps},
+            {nullptr, 0, &q, &qDeps},
+            {nullptr, 0, &r, &rDeps}
+         });
+
+         THEN("Modules fall back to sequential updates by priority") {
+            REQUIRE(graph.IsCyclic());
+            REQUIRE(not graph.IsConcurrent());
+            REQUIRE(order(graph) == ::std::vector<Offset> {0, 1, 2});
+            REQUIRE(graph.GetNodes()[0].mSuccessors == ::std::vector<Offset> {1});
+            REQUIRE(graph.GetNodes()[1].mSuccessors == ::std::vector<Offset> {2});
+            REQUIRE(graph.GetNodes()[2].mSuccessors.empty());
+         }
+      }
+   }
+
+   REQUIRE(memoryState.Assert());
+}
+
+SCENARIO("Updating a hierarchy in parallel", "[runtime]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A root with parallel update, and subtrees that own their runtimes") {
+      auto root = Thing::Root();
+      root.GetRuntime()->SetParallelUpdate(true, 4);
+
+      for (int i = 0; i < 16; ++i) {
+         auto subtree = root.CreateChild(Traits::Name {"Subtree"});
+         subtree->CreateRuntime();
+         subtree->CreateChild(Traits::Name {"Leaf"});
+      }
+
+      WHEN("Updated") {
+         const bool result = root.Update({});
+
+         REQUIRE(result);
+         REQUIRE(not root.RequiresRefresh());
+         for (auto& subtree : root.GetChildren()) {
+            REQUIRE(not subtree->RequiresRefresh());
+            REQUIRE(not subtree->GetChild()->RequiresRefresh());
+         }
+      }
+
+      WHEN("Nested runtimes are asked for a scheduler") {
+         // All runtimes share a single pool of workers                 
+         auto& scheduler = root.GetRuntime()->GetScheduler();
+         for (auto& subtree : root.GetChildren())
+            REQUIRE(&subtree->GetRuntime()->GetScheduler() == &scheduler);
+      }
+
+      WHEN("Subtrees change while being updated again") {
+         root.Update({});
+         for (auto& subtree : root.GetChildren())
+            subtree->GetChild()->AddTrait(Traits::Count {1});
+         REQUIRE(root.RequiresRefreshBelow());
+
+         // Every subtree is updated, regardless of the order in which  
+         // the scheduler runs them, so all of them end up refreshed    
+         REQUIRE(root.Update({}));
+         for (auto& subtree : root.GetChildren()) {
+            REQUIRE(not subtree->RequiresRefresh());
+            REQUIRE(not subtree->GetChild()->RequiresRefresh());
+         }
+      }
+   }
+
+   GIVEN("A root with parallel update, and subtrees that share its runtime") {
+      auto root = Thing::Root();
+      root.GetRuntime()->SetParallelUpdate(true, 4);
+
+      for (int i = 0; i < 16; ++i) {
+         auto subtree = root.CreateChild(Traits::Name {"Subtree"});
+         subtree->CreateFlow();
+         subtree->CreateChild(Traits::Name {"Leaf"});
+      }
+
+      WHEN("Updated") {
+         // Subtrees that own only their flow are updated on this       
+         // thread, because they share the root's runtime               
+         REQUIRE(root.Update({}));
+         for (auto& subtree : root.GetChildren()) {
+            REQUIRE(&*subtree->GetRuntime() == &*root.GetRuntime());
+            REQUIRE(not subtree->RequiresRefresh());
+            REQUIRE(not subtree->GetChild()->RequiresRefresh());
+         }
+      }
+   }
+
+   REQUIRE(memoryState.Assert());
+}
+
+SCENARIO("Iterating units through archetypes", "[runtime]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A root with archetypes, and children with different units") {
+      auto root = Thing::Root();
+      root.GetRuntime()->SetArchetypes(true);
+
+      for (int i = 0; i < 4; ++i) {
+         auto child = root.CreateChild(Traits::Name {"Both"});
+         child->CreateUnit<TestUnit1>();
+         child->CreateUnit<TestUnit2>();
+      }
+
+      for (int i = 0; i < 3; ++i) {
+         auto child = root.CreateChild(Traits::Name {"First"});
+         child->CreateUnit<TestUnit1>();
+      }
+
+      WHEN("Iterating chunks that contain TestUnit1") {
+         Count rows = 0;
+         const auto chunks = root.GetRuntime()->ForEachChunk<TestUnit1>(
+            [&](const auto& chunk) {
+               const auto column = chunk.template GetColumn<TestUnit1>();
+               REQUIRE(column.size() == chunk.mCount);
+               REQUIRE(chunk.GetOwners().size() == chunk.mCount);
+               for (Offset i = 0; i < chunk.mCount; ++i)
+                  REQUIRE(column[i]->GetOwners().Find(chunk.GetOwners()[i]));
+               rows += chunk.mCount;
+            }
+         );
+
+         REQUIRE(chunks == 2);
+         REQUIRE(rows == 7);
+         REQUIRE(root.GetRuntime()->GetArchetypes()->GetArchetypeCount() == 2);
+      }
+
+      WHEN("Iterating chunks that contain both units") {
+         Count rows = 0;
+         root.GetRuntime()->ForEachChunk<TestUnit1, TestUnit2>(
+            [&](const auto& chunk) {
+               REQUIRE(chunk.template GetColumn<TestUnit2>().size() == chunk.mCount);
+               rows += chunk.mCount;
+            }
+         );
+
+         REQUIRE(rows == 4);
+      }
+
+      WHEN("Units are removed from some of the children") {
+         for (auto& child : root.GetChildren()) {
+            if (child->HasUnits<TestUnit2>())
+               child->RemoveUnits<TestUnit2>();
+         }
+
+         Count rows = 0;
+         root.GetRuntime()->ForEachChunk<TestUnit1, TestUnit2>(
+            [&](const auto& chunk) { rows += chunk.mCount; }
+         );
+         REQUIRE(rows == 0);
+         REQUIRE(root.GetRuntime()->GetArchetypes()->GetArchetypeCount() == 1);
+
+         root.GetRuntime()->ForEachChunk<TestUnit1>(
+            [&](const auto& chunk) { rows += chunk.mCount; }
+         );
+         REQUIRE(rows == 7);
+      }
+   }
+
+   REQUIRE(memoryState.Assert());
+}
+
+SCENARIO("Querying Things by multiple unit types", "[runtime]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A root with children that have different units") {
+      auto root = Thing::Root();
+
+      for (int i = 0; i < 100; ++i) {
+         auto child = root.CreateChild(Traits::Name {"Both"});
+         child->CreateUnit<TestUnit1>();
+         child->CreateUnit<TestUnit2>();
+      }
+
+      auto single = root.CreateChild(Traits::Name {"First"});
+      single->CreateUnit<TestUnit1>();
+
+      auto query = root.GetRuntime()->GetQuery<TestUnit1, TestUnit2>();
+
+      WHEN("Iterating the query") {
+         const auto visited = query.ForEach(
+            [&](Thing& owner, TestUnit1& a, TestUnit2& b) {
+               REQUIRE(owner.GetUnit<TestUnit1>() == &a);
+               REQUIRE(owner.GetUnit<TestUnit2>() == &b);
+            }
+         );
+
+         REQUIRE(query.GetCount() == 100);
+         REQUIRE(visited == 100);
+         REQUIRE(not query.GetQuery()->Contains(&*single));
+         REQUIRE(root.GetRuntime()->GetQuery<TestUnit1, TestUnit2>().GetQuery() == query.GetQuery());
+      }
+
+      WHEN("Iterating the query in parallel") {
+         ::std::atomic<Count> visited {};
+         query.ForEachParallel([&](Thing&, TestUnit1&, TestUnit2&) {
+            visited.fetch_add(1, ::std::memory_order_relaxed);
+         }, 16);
+
+         REQUIRE(visited == 100);
+      }
+
+      WHEN("Units are added and removed") {
+         single->CreateUnit<TestUnit2>();
+         REQUIRE(query.GetCount() == 101);
+         REQUIRE(query.GetQuery()->Contains(&*single));
+
+         single->RemoveUnits<TestUnit1>();
+         REQUIRE(query.GetCount() == 100);
+         REQUIRE(not query.GetQuery()->Contains(&*single));
+      }
+
+      WHEN("A matching child is removed") {
+         auto child = root.GetChild();
+         root.RemoveChild(&*child);
+         REQUIRE(query.GetCount() == 99);
+      }
+   }
+
+   REQUIRE(memoryState.Assert());
+}
+
+SCENARIO("Deferring structural changes until the end of the update", "[runtime]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A root with a child, that has a unit") {
+      auto root = Thing::Root();
+      auto child = root.CreateChild(Traits::Name {"Child"});
+      child->CreateUnit<TestUnit1>();
+      auto& commands = root.GetRuntime()->GetCommands();
+
+      WHEN("Changes are recorded") {
+         commands.CreateChild(&root, Many {Traits::Name {"Deferred"}});
+         commands.AddTrait(&*child, Traits::Count {5});
+         commands.RemoveUnit(&*child, child->GetUnit<TestUnit1>());
+
+         REQUIRE(commands.GetCount() == 3);
+         REQUIRE(root.GetChildren().GetCount() == 1);
+         REQUIRE(not child->HasTraits(MetaTraitOf<Traits::Count>()));
+         REQUIRE(child->HasUnits<TestUnit1>() == 1);
+
+         THEN("They're applied when the root is updated") {
+            REQUIRE(root.Update({}));
+            REQUIRE(commands.GetCount() == 0);
+            REQUIRE(root.GetChildren().GetCount() == 2);
+            REQUIRE(root.GetNamedChild("Deferred"));
+            REQUIRE(child->HasTraits(MetaTraitOf<Traits::Count>()) == 1);
+            REQUIRE(child->HasUnits<TestUnit1>() == 0);
+         }
+      }
+
+      WHEN("Children are created from multiple threads") {
+         ::std::vector<::std::thread> threads;
+         for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&] {
+               for (int i = 0; i < 25; ++i)
+                  commands.CreateChild(&*child);
+            });
+         }
+
+         for (auto& thread : threads)
+            thread.join();
+
+         REQUIRE(commands.GetCount() == 100);
+         REQUIRE(commands.Flush() == 100);
+         REQUIRE(child->GetChildren().GetCount() == 100);
+      }
+
+      WHEN("A child is destroyed") {
+         commands.Destroy(&*child);
+         REQUIRE(root.GetChildren().GetCount() == 1);
+         REQUIRE(root.Update({}));
+         REQUIRE(root.GetChildren().GetCount() == 0);
+      }
+
+      WHEN("A child is destroyed, and changed later in the same flush") {
+         // Only the root references the new child                      
+         Thing* temporary = &*root.CreateChild();
+         commands.Destroy(temporary);
+         commands.AddTrait(temporary, Traits::Count {1});
+
+         REQUIRE(root.GetChildren().GetCount() == 2);
+         REQUIRE(commands.Flush() == 2);
+         REQUIRE(root.GetChildren().GetCount() == 1);
+      }
+   }
+
+   REQUIRE(memoryState.Assert());
+}
+
+SCENARIO("Finding Things by indexed trait values", "[runtime]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A root with children, that have names and counts") {
+      auto root = Thing::Root();
+      auto runtime = root.GetRuntime();
+      runtime->AddTraitIndex(MetaTraitOf<Traits::Name>());
+
+      for (int i = 0; i < 10; ++i) {
+         root.CreateChild(Many {
+            Traits::Name {i % 2 ? "Odd" : "Even"},
+            Traits::Count {i}
+         });
+      }
+
+      runtime->AddTraitIndex(MetaTraitOf<Traits::Count>(), TraitIndex::Kind::Ordered);
+
+      WHEN("Searching by equal values") {
+         REQUIRE(runtime->FindByTrait<Traits::Name>(Text {"Odd"}).GetCount() == 5);
+         REQUIRE(runtime->FindByTrait<Traits::Name>(Text {"Even"}).GetCount() == 5);
+         REQUIRE(runtime->FindByTrait<Traits::Name>(Text {"None"}).IsEmpty());
+
+         const auto found = runtime->FindByTrait<Traits::Count>(Many {7});
+         REQUIRE(found.GetCount() == 1);
+         REQUIRE(found[0] == root.GetChild(7));
+      }
+
+      WHEN("Searching by a range of values") {
+         const auto found = runtime->FindByTraitRange(
+            MetaTraitOf<Traits::Count>(), 3, 5);
+         REQUIRE(found.GetCount() == 3);
+         REQUIRE(found[0] == root.GetChild(3));
+         REQUIRE(found[2] == root.GetChild(5));
+      }
+
+      WHEN("Traits are changed and removed") {
+         root.GetChild(0)->SetName("Odd");
+         REQUIRE(runtime->FindByTrait<Traits::Name>(Text {"Odd"}).GetCount() == 6);
+         REQUIRE(runtime->FindByTrait<Traits::Name>(Text {"Even"}).GetCount() == 4);
+
+         root.GetChild(1)->RemoveTrait(MetaTraitOf<Traits::Name>());
+         REQUIRE(runtime->FindByTrait<Traits::Name>(Text {"Odd"}).GetCount() == 5);
+         REQUIRE(runtime->GetTraitIndex(MetaTraitOf<Traits::Name>())->GetCount() == 9);
+      }
+
+      WHEN("A Thing has two equal traits") {
+         root.GetChild(3)->AddTrait(Traits::Count {3});
+         const auto found = runtime->FindByTrait<Traits::Count>(Many {3});
+         REQUIRE(found.GetCount() == 1);
+         REQUIRE(found[0] == root.GetChild(3));
+         REQUIRE(runtime->FindByTraitRange(
+            MetaTraitOf<Traits::Count>(), 3, 3).GetCount() == 1);
+
+         const auto index = runtime->GetTraitIndex(MetaTraitOf<Traits::Count>());
+         REQUIRE(index->GetCount() == 11);
+
+         root.GetChild(3)->RemoveTrait(Traits::Count {3});
+         REQUIRE(runtime->FindByTrait<Traits::Count>(Many {3}).IsEmpty());
+         REQUIRE(index->GetCount() == 9);
+      }
+
+      WHEN("A child is removed") {
+         root.RemoveChild(root.GetChild(7));
+         REQUIRE(runtime->FindByTrait<Traits::Count>(Many {7}).IsEmpty());
+         REQUIRE(runtime->FindByTrait<Traits::Name>(Text {"Odd"}).GetCount() == 4);
+      }
+
+      WHEN("Searching a trait type, that isn't indexed") {
+         root.GetChild(4)->AddTrait(Traits::Index {42});
+         const auto found = runtime->FindByTrait<Traits::Index>(Many {42});
+         REQUIRE(found.GetCount() == 1);
+         REQUIRE(found[0] == root.GetChild(4));
+      }
+   }
+
+   REQUIRE(memoryState.Assert());
+}
+
+SCENARIO("Observing changes in the hierarchy", "[runtime]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A root with an observer") {
+      auto root = Thing::Root();
+      auto runtime = root.GetRuntime();
+      ::std::vector<Change::Kind> observed;
+      const auto observer = runtime->AddObserver([&](const Change& change) {
+         observed.push_back(change.mKind);
+      });
+
+      WHEN("Children, traits and units are changed") {
+         auto child = root.CreateChild();
+         child->AddTrait(Traits::Count {5});
+         child->SetName("Child");
+         child->SetName("Renamed");
+         auto unit = child->CreateUnit<TestUnit1>();
+         child->RemoveUnit(unit);
+         child->RemoveTrait(MetaTraitOf<Traits::Count>());
+
+         REQUIRE(observed == ::std::vector<Change::Kind> {
+            Change::ChildAttached,
+            Change::TraitAdded,
+            Change::TraitAdded,
+            Change::TraitChanged,
+            Change::UnitAdded,
+            Change::UnitRemoved,
+            Change::TraitRemoved
+         });
+
+         THEN("Changed Things aren't collected by default") {
+            REQUIRE_FALSE(runtime->IsTrackingChanges());
+            REQUIRE(root.Update({}));
+            REQUIRE(runtime->GetChangedThings().IsEmpty());
+         }
+
+         THEN("A detached child is reported before it is removed") {
+            observed.clear();
+            root.RemoveChild(&*child);
+            REQUIRE(observed == ::std::vector<Change::Kind> {Change::ChildDetached});
+         }
+      }
+
+      WHEN("Changes are tracked") {
+         runtime->SetChangeTracking(true);
+         auto child = root.CreateChild();
+         child->AddTrait(Traits::Count {5});
+         child->CreateUnit<TestUnit1>();
+
+         THEN("The changed Things are available after the update") {
+            REQUIRE(runtime->GetChangedThings().IsEmpty());
+            REQUIRE(root.Update({}));
+
+            const auto& changed = runtime->GetChangedThings();
+            REQUIRE(changed.GetCount() == 2);
+            REQUIRE(changed.Find(&root));
+            REQUIRE(changed.Find(&*child));
+
+            REQUIRE(root.Update({}));
+            REQUIRE(runtime->GetChangedThings().IsEmpty());
+         }
+
+         THEN("Removing all units of a Thing marks it as changed") {
+            REQUIRE(root.Update({}));
+            REQUIRE(child->RemoveUnits<A::Unit>() == 1);
+            REQUIRE(root.Update({}));
+
+            const auto& changed = runtime->GetChangedThings();
+            REQUIRE(changed.GetCount() == 1);
+            REQUIRE(changed[0] == &*child);
+         }
+
+         THEN("A destroyed Thing is forgotten") {
+            REQUIRE(root.Update({}));
+            REQUIRE(runtime->GetChangedThings().GetCount() == 2);
+
+            root.RemoveChild(&*child);
+            child.Reset();
+
+            const auto& changed = runtime->GetChangedThings();
+            REQUIRE(changed.GetCount() == 1);
+            REQUIRE(changed[0] == &root);
+         }
+
+         runtime->SetChangeTracking(false);
+      }
+
+      WHEN("A Thing is cleared") {
+         auto child = root.CreateChild(Traits::Count {5});
+         child->CreateChild();
+         child->CreateUnit<TestUnit1>();
+         observed.clear();
+         child->Clear();
+
+         REQUIRE(observed == ::std::vector<Change::Kind> {
+            Change::ChildDetached,
+            Change::UnitRemoved,
+            Change::TraitRemoved
+         });
+      }
+
+      WHEN("The observer is removed") {
+         runtime->RemoveObserver(observer);
+         root.CreateChild(Traits::Name {"Child"});
+         REQUIRE(observed.empty());
+      }
+   }
+
+   REQUIRE(memoryState.Assert());
+}
+
+SCENARIO("Recycling Things through the runtime's pool", "[runtime]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A root with a pool of Things") {
+      auto root = Thing::Root();
+      auto runtime = root.GetRuntime();
+      runtime->SetThingPool(2);
+      const auto pool = runtime->GetThingPool();
+
+      auto bullet = root.CreateChild(
+         Traits::Name {"Bullet"}, Construct::From<TestUnit1>());
+      const auto first = &*bullet;
+      REQUIRE(pool->GetMisses() == 1);
+
+      WHEN("A child is recycled and created again") {
+         bullet->Recycle();
+         bullet.Reset();
+         REQUIRE(root.GetChildren().GetCount() == 0);
+         REQUIRE(pool->GetCount() == 1);
+
+         auto reused = root.CreateChild(
+            Traits::Name {"Bullet"}, Construct::From<TestUnit1>());
+         REQUIRE(&*reused == first);
+         REQUIRE(pool->GetHits() == 1);
+         REQUIRE(pool->GetCount() == 0);
+         REQUIRE(reused->GetOwner() == &root);
+         REQUIRE(reused->GetName() == "Bullet");
+         REQUIRE(reused->HasUnits<TestUnit1>() == 1);
+         REQUIRE(root.GetChildren().GetCount() == 1);
+      }
+
+      WHEN("A child is created from another descriptor") {
+         bullet->Recycle();
+         bullet.Reset();
+
+         auto rocket = root.CreateChild(Traits::Name {"Rocket"});
+         REQUIRE(&*rocket != first);
+         REQUIRE(pool->GetHits() == 0);
+         REQUIRE(pool->GetMisses() == 2);
+         REQUIRE(pool->GetCount() == 1);
+      }
+
+      WHEN("More children are recycled, than the pool can hold") {
+         for (int i = 0; i < 3; ++i) {
+            root.CreateChild(
+               Traits::Name {"Bullet"}, Construct::From<TestUnit1>());
+         }
+
+         while (root.GetChildren())
+            root.GetChild(0)->Recycle();
+         bullet.Reset();
+         REQUIRE(pool->GetCount() == 2);
+
+         runtime->SetThingPool(0);
+         REQUIRE(runtime->GetThingPool() == nullptr);
+      }
+
+      WHEN("A child is recycled, while the pool is full") {
+         for (int i = 0; i < 2; ++i) {
+            root.CreateChild(
+               Traits::Name {"Bullet"}, Construct::From<TestUnit1>());
+         }
+         while (root.GetChildren().GetCount() > 1)
+            root.GetChild(1)->Recycle();
+         REQUIRE(pool->GetCount() == 2);
+
+         const auto handle = bullet->GetHandle();
+         bullet->Recycle();
+         REQUIRE(pool->GetCount() == 2);
+         REQUIRE(root.GetChildren().GetCount() == 0);
+         REQUIRE(bullet->GetName() == "Bullet");
+         REQUIRE(bullet->HasUnits<TestUnit1>() == 1);
+         REQUIRE(runtime->Resolve(handle) == first);
+      }
+   }
+
+   REQUIRE(memoryState.Assert());
+}
+
+SCENARIO("Referring to Things and units by handle", "[runtime]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A root with a child and a unit") {
+      auto root = Thing::Root();
+      auto runtime = root.GetRuntime();
+      auto child = root.CreateChild(Construct::From<TestUnit1>());
+      auto unit = child->GetUnit<TestUnit1>();
+
+      const auto childHandle = child->GetHandle();
+      const auto unitHandle = unit->GetHandle();
+
+      WHEN("Handles are resolved") {
+         REQUIRE(sizeof(childHandle) == 4);
+         REQUIRE(childHandle);
+         REQUIRE(unitHandle);
+         REQUIRE(child->GetHandle() == childHandle);
+         REQUIRE(runtime->Resolve(childHandle) == &*child);
+         REQUIRE(runtime->Resolve(unitHandle) == unit);
+         REQUIRE(runtime->GetHandleCount() == 2);
+      }
+
+      WHEN("Handles are gathered") {
+         const auto units = root.GatherUnitHandles<Seek::HereAndBelow>(
+            MetaDataOf<TestUnit1>());
+         REQUIRE(units.GetCount() == 1);
+         REQUIRE(units[0] == unitHandle);
+
+         const auto children = root.GatherChildHandles();
+         REQUIRE(children.GetCount() == 1);
+         REQUIRE(children[0] == childHandle);
+      }
+
+      WHEN("The unit is removed") {
+         child->RemoveUnit(unit);
+         REQUIRE(runtime->Resolve(unitHandle) == nullptr);
+         REQUIRE(runtime->Resolve(childHandle) == &*child);
+      }
+
+      WHEN("The child is destroyed, and another one is made") {
+         root.RemoveChild(&*child);
+         child.Reset();
+         REQUIRE(runtime->Resolve(childHandle) == nullptr);
+         REQUIRE(runtime->Resolve(unitHandle) == nullptr);
+         REQUIRE(runtime->GetHandleCount() == 0);
+
+         auto other = root.CreateChild();
+         const auto otherHandle = other->GetHandle();
+         REQUIRE(otherHandle.GetIndex() == childHandle.GetIndex());
+         REQUIRE(otherHandle != childHandle);
+         REQUIRE(runtime->Resolve(otherHandle) == &*other);
+         REQUIRE(runtime->Resolve(childHandle) == nullptr);
+      }
+   }
+
+   REQUIRE(memoryState.Assert());
+}
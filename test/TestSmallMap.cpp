@@ -0,0 +1,228 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include <span>
+#include "Common.hpp"
+
+using SmallMap = Entity::TSmallMap<DMeta, TMany<int>, 4>;
+
+
+SCENARIO("Small map with inline storage", "[smallmap]") {
+   static Allocator::State memoryState;
+
+   const DMeta keys[] {
+      MetaDataOf<TestUnit1>(), MetaDataOf<TestUnit2>(),
+      MetaDataOf<int>(), MetaDataOf<Real>(), MetaDataOf<Text>(),
+      MetaDataOf<Thing>()
+   };
+
+   GIVEN("An empty map") {
+      SmallMap map;
+
+      REQUIRE(not map);
+      REQUIRE(map.IsEmpty());
+      REQUIRE(not map.FindIt(keys[0]));
+
+      WHEN("Inserting up to the inline capacity") {
+         for (int i = 0; i < 4; ++i)
+            map.Insert(keys[i], i);
+
+         REQUIRE(map.GetCount() == 4);
+         REQUIRE(not map.IsOverflown());
+         for (int i = 0; i < 4; ++i) {
+            REQUIRE(map.FindIt(keys[i]));
+            REQUIRE(map.FindIt(keys[i]).GetKey() == keys[i]);
+            REQUIRE(map[keys[i]] == TMany<int> {i});
+         }
+
+         Count iterated = 0;
+         for (auto pair : map) {
+            REQUIRE(pair.mValue.GetCount() == 1);
+            ++iterated;
+         }
+         REQUIRE(iterated == 4);
+      }
+
+      WHEN("Inserting past the inline capacity") {
+         for (int i = 0; i < 6; ++i)
+            map.Insert(keys[i], i);
+
+         REQUIRE(map.GetCount() == 6);
+         REQUIRE(map.IsOverflown());
+         for (int i = 0; i < 6; ++i)
+            REQUIRE(map[keys[i]] == TMany<int> {i});
+
+         for (int i = 0; i < 6; ++i)
+            map.RemoveIt(map.FindIt(keys[i]));
+
+         REQUIRE(map.IsEmpty());
+         REQUIRE(not map.IsOverflown());
+      }
+
+      WHEN("Removing inline pairs") {
+         for (int i = 0; i < 4; ++i)
+            map.Insert(keys[i], i);
+
+         map.RemoveIt(map.FindIt(keys[1]));
+         REQUIRE(map.GetCount() == 3);
+         REQUIRE(not map.FindIt(keys[1]));
+         REQUIRE(map[keys[2]] == TMany<int> {2});
+
+         auto moved = ::std::move(map);
+         REQUIRE(map.IsEmpty());
+         REQUIRE(moved.GetCount() == 3);
+         REQUIRE(moved[keys[3]] == TMany<int> {3});
+      }
+
+      WHEN("Appending an element to many keys at once") {
+         map.Insert(keys[1], 1);
+         map.Append(::std::span {keys, 3}, 7);
+
+         REQUIRE(map.GetCount() == 3);
+         REQUIRE(not map.IsOverflown());
+         REQUIRE(map[keys[0]] == TMany<int> {7});
+         REQUIRE(map[keys[1]] == TMany<int> {1, 7});
+         REQUIRE(map[keys[2]] == TMany<int> {7});
+
+         map.Append(::std::span {keys + 2, 4}, 8);
+         REQUIRE(map.GetCount() == 6);
+         REQUIRE(map.IsOverflown());
+         REQUIRE(map[keys[1]] == TMany<int> {1, 7});
+         REQUIRE(map[keys[2]] == TMany<int> {7, 8});
+         REQUIRE(map[keys[5]] == TMany<int> {8});
+      }
+
+      WHEN("Copying an overflown map") {
+         for (int i = 0; i < 6; ++i)
+            map.Insert(keys[i], i);
+
+         SmallMap copy {map};
+         REQUIRE(copy.IsOverflown());
+         REQUIRE(copy == map);
+
+         copy.Reset();
+         REQUIRE(copy.IsEmpty());
+         REQUIRE(not copy.IsOverflown());
+         REQUIRE(map.GetCount() == 6);
+      }
+
+      WHEN("Comparing maps with different insertion order") {
+         SmallMap other;
+         for (int i = 0; i < 4; ++i) {
+            map.Insert(keys[i], i);
+            other.Insert(keys[3 - i], 3 - i);
+         }
+
+         REQUIRE(map == other);
+         other.Insert(keys[0], 5);
+         REQUIRE(map != other);
+      }
+   }
+
+   GIVEN("A Thing with typical units and traits") {
+      Thing thing;
+      thing.CreateUnit<TestUnit1>();
+      thing.CreateUnit<TestUnit2>();
+      thing.AddTrait(Traits::Name {"Dimo"});
+      thing.AddTrait(Traits::Count {666});
+
+      THEN("Both of its maps keep their pairs inline") {
+         REQUIRE(Entity::InlineUnitTypes >= 4);
+         REQUIRE(Entity::InlineTraitTypes >= 4);
+         REQUIRE(thing.GetUnitsMap().GetCount() >= 2);
+         REQUIRE(thing.GetUnitsMap().GetCount() <= Entity::InlineUnitTypes);
+         REQUIRE(not thing.GetUnitsMap().IsOverflown());
+         REQUIRE(thing.GetTraits().GetCount() == 2);
+         REQUIRE(not thing.GetTraits().IsOverflown());
+      }
+   }
+
+   REQUIRE(memoryState.Assert());
+}
+
+SCENARIO("Things with small maps against hash maps", "[smallmap][!benchmark]") {
+   using UnitHashMap = TUnorderedMap<DMeta, Entity::UnitList>;
+   using TraitHashMap = TUnorderedMap<TMeta, TraitList>;
+
+   GIVEN("A Thing with typical units and traits") {
+      Thing thing;
+      thing.CreateUnit<TestUnit1>();
+      thing.CreateUnit<TestUnit2>();
+      thing.AddTrait(Traits::Name {"Dimo"});
+      thing.AddTrait(Traits::Count {666});
+
+      // The hash maps a Thing used before, with the same pairs         
+      UnitHashMap unitHash;
+      for (auto pair : thing.GetUnitsMap())
+         unitHash.Insert(pair.mKey, pair.mValue);
+      TraitHashMap traitHash;
+      for (auto pair : thing.GetTraits())
+         traitHash.Insert(pair.mKey, pair.mValue);
+
+      // A hash map allocates a table for keys, values and info bytes   
+      const auto unitTable = unitHash.GetReserved()
+         * (sizeof(DMeta) + sizeof(Entity::UnitList) + 1);
+      const auto traitTable = traitHash.GetReserved()
+         * (sizeof(TMeta) + sizeof(TraitList) + 1);
+      const auto before = sizeof(Thing)
+         - sizeof(Entity::UnitMap) - sizeof(Entity::TraitMap)
+         + sizeof(UnitHashMap) + sizeof(TraitHashMap)
+         + unitTable + traitTable;
+      const auto after = sizeof(Thing)
+         + (thing.GetUnitsMap().IsOverflown() ? unitTable : 0)
+         + (thing.GetTraits().IsOverflown() ? traitTable : 0);
+      Logger::Info("Memory per Thing with ", thing.GetUnitsMap().GetCount(),
+         " unit types and ", thing.GetTraits().GetCount(), " trait types: ",
+         before, " bytes in 2 allocations with hash maps, ", after,
+         " bytes in 1 allocation with small maps");
+
+      const DMeta units[] {
+         MetaDataOf<TestUnit1>(), MetaDataOf<TestUnit2>(),
+         MetaDataOf<Thing>()
+      };
+      const TMeta traits[] {
+         MetaTraitOf<Traits::Name>(), MetaTraitOf<Traits::Count>(),
+         MetaTraitOf<Traits::Parent>()
+      };
+
+      BENCHMARK_ADVANCED("Unit lookup in Thing (small map)") (timer meter) {
+         meter.measure([&](int i) {
+            return thing.GetUnitsMap().FindIt(units[i % 3]) ? 1 : 0;
+         });
+      };
+
+      BENCHMARK_ADVANCED("Unit lookup in TUnorderedMap") (timer meter) {
+         meter.measure([&](int i) {
+            return unitHash.FindIt(units[i % 3]) ? 1 : 0;
+         });
+      };
+
+      BENCHMARK_ADVANCED("Trait lookup in Thing (small map)") (timer meter) {
+         meter.measure([&](int i) {
+            return thing.GetTraits().FindIt(traits[i % 3]) ? 1 : 0;
+         });
+      };
+
+      BENCHMARK_ADVANCED("Trait lookup in TUnorderedMap") (timer meter) {
+         meter.measure([&](int i) {
+            return traitHash.FindIt(traits[i % 3]) ? 1 : 0;
+         });
+      };
+
+      BENCHMARK_ADVANCED("Thing::GetUnit") (timer meter) {
+         meter.measure([&] {
+            return thing.GetUnit<TestUnit2>();
+         });
+      };
+
+      BENCHMARK_ADVANCED("Thing::GetTrait") (timer meter) {
+         meter.measure([&] {
+            return thing.GetTrait(MetaTraitOf<Traits::Count>());
+         });
+      };
+   }
+}
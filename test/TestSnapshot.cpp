@@ -0,0 +1,150 @@
+///                                                                           
+/// Langulus::Entity                                                          
+/// Copyright (c) 2013 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include <utility>
+#include "Common.hpp"
+
+#if LANGULUS_FEATURE(MANAGED_REFLECTION)
+
+/// Create a descriptor for a scene of a given number of children             
+///   @param count - number of children                                       
+///   @return the descriptor                                                  
+Many CreateSceneDescriptor(int count) {
+   Many descriptor;
+   descriptor << Traits::Name {"Scene"};
+   descriptor << Construct::From<TestUnit1>();
+   for (int i = 0; i < count; ++i) {
+      descriptor << Construct::From<Thing>(
+         Traits::Name {"Child"},
+         Traits::Count {i},
+         Construct::From<TestUnit1>(),
+         Construct::From<TestUnit2>(),
+         Construct::From<Thing>(Traits::Name {"GrandChild"})
+      );
+   }
+   return descriptor;
+}
+
+
+SCENARIO("Saving and loading binary snapshots", "[snapshot]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A hierarchy with traits, units, and children") {
+      Thing scene;
+      scene.CreateRuntime();
+      Verbs::Create creator {CreateSceneDescriptor(3)};
+      scene.Create(creator);
+
+      WHEN("Saved and loaded into another Thing") {
+         const auto snapshot = scene.Save();
+         REQUIRE(snapshot.size() > 8);
+
+         Thing loaded;
+         loaded.CreateRuntime();
+         loaded.Load(snapshot);
+
+         REQUIRE(loaded.GetName() == "Scene");
+         REQUIRE(loaded.HasUnits<TestUnit1>() == 1);
+         REQUIRE(loaded.GetChildren().GetCount() == 3);
+
+         for (int i = 0; i < 3; ++i) {
+            auto child = loaded.GetChildren()[i];
+            REQUIRE(child->GetOwner() == &loaded);
+            REQUIRE(child->GetName() == "Child");
+            REQUIRE(*child->GetLocalTrait<Traits::Count>() == Traits::Count {i});
+            REQUIRE(child->HasUnits<TestUnit1>() == 1);
+            REQUIRE(child->HasUnits<TestUnit2>() == 1);
+            REQUIRE(child->GetChildren().GetCount() == 1);
+            REQUIRE(child->GetNamedChild("GrandChild"));
+         }
+
+         REQUIRE(loaded.Save() == snapshot);
+      }
+
+      WHEN("Saving POD data, that is valid only in the saved runtime") {
+         scene.AddTrait(Trait::From<Traits::Count>(scene.GetHandle()));
+         const auto snapshot = scene.Save();
+
+         Thing loaded;
+         loaded.CreateRuntime();
+         loaded.Load(snapshot);
+
+         // The handle is skipped, so the trait is loaded without data  
+         const auto traits = loaded.GetTraits()
+            .FindIt(MetaTraitOf<Traits::Count>());
+         REQUIRE(traits);
+         Count handles {};
+         for (auto& trait : traits.GetValue()) {
+            if (trait.GetType() == MetaDataOf<Entity::ThingHandle>()) {
+               REQUIRE(trait.IsEmpty());
+               ++handles;
+            }
+         }
+         REQUIRE(handles == 1);
+      }
+
+      WHEN("Loading a corrupted snapshot") {
+         auto snapshot = scene.Save();
+         snapshot[0] = Byte {0};
+
+         Thing loaded;
+         REQUIRE_THROWS(loaded.Load(snapshot));
+      }
+
+      WHEN("Loading a snapshot from a host with another byte order") {
+         auto snapshot = scene.Save();
+         ::std::swap(snapshot[4], snapshot[7]);
+         ::std::swap(snapshot[5], snapshot[6]);
+
+         Thing loaded;
+         REQUIRE_THROWS(loaded.Load(snapshot));
+      }
+
+      WHEN("Loading a truncated snapshot") {
+         auto snapshot = scene.Save();
+         snapshot.Trim(snapshot.GetCount() / 2);
+
+         Thing loaded;
+         loaded.CreateRuntime();
+         REQUIRE_THROWS(loaded.Load(snapshot));
+      }
+   }
+
+   REQUIRE(memoryState.Assert());
+}
+
+SCENARIO("Loading snapshots against creating by descriptor", "[snapshot][!benchmark]") {
+   GIVEN("A large scene") {
+      const auto descriptor = CreateSceneDescriptor(100);
+      Thing scene;
+      scene.CreateRuntime();
+      Verbs::Create creator {descriptor};
+      scene.Create(creator);
+      const auto snapshot = scene.Save();
+
+      BENCHMARK_ADVANCED("Loading a scene by descriptor") (timer meter) {
+         meter.measure([&] {
+            Thing loaded;
+            loaded.CreateRuntime();
+            Verbs::Create create {descriptor};
+            loaded.Create(create);
+            return loaded.GetChildren().GetCount();
+         });
+      };
+
+      BENCHMARK_ADVANCED("Loading a scene from a snapshot") (timer meter) {
+         meter.measure([&] {
+            Thing loaded;
+            loaded.CreateRuntime();
+            loaded.Load(snapshot);
+            return loaded.GetChildren().GetCount();
+         });
+      };
+   }
+}
+
+#endif
@@ -338,6 +338,154 @@ TEMPLATE_TEST_CASE("Testing Thing with different kidns of descriptors",
 
       Thing root {Describe(descriptor)};
 
+      WHEN("Cloning the hierarchy") {
+         Thing clone {Clone(root)};
+
+         REQUIRE(clone.GetName() == "Root");
+         REQUIRE(clone.GetRuntime().IsLocked());
+         REQUIRE(&*clone.GetRuntime() != &*root.GetRuntime());
+         REQUIRE(clone.GetFlow().IsLocked());
+         REQUIRE(clone.HasUnits<TestUnit1>() == 1);
+         REQUIRE(clone.HasUnits<TestUnit2>() == 1);
+         REQUIRE(clone.GetUnit<TestUnit1>() != root.GetUnit<TestUnit1>());
+         REQUIRE(clone.GetChildren().GetCount() == 3);
+
+         auto child1 = clone.GetNamedChild("Child1");
+         REQUIRE(child1);
+         REQUIRE(child1->GetOwner() == &clone);
+         REQUIRE(&*child1->GetRuntime() == &*clone.GetRuntime());
+         REQUIRE(child1->HasUnits<TestUnit1>() == 1);
+         REQUIRE(child1->GetChildren().GetCount() == 2);
+         REQUIRE(child1->GetNamedChild("GrandChild2"));
+      }
+
+      WHEN("Cloning a child multiple times") {
+         auto child1 = root.GetNamedChild("Child1");
+         auto copies = child1->CloneN(10, &root);
+
+         REQUIRE(copies.GetCount() == 10);
+         REQUIRE(root.GetChildren().GetCount() == 13);
+         for (auto copy : copies) {
+            REQUIRE(copy->GetOwner() == &root);
+            REQUIRE(copy->GetName() == "Child1");
+            REQUIRE(copy->HasUnits<TestUnit2>() == 1);
+            REQUIRE(copy->GetChildren().GetCount() == 2);
+         }
+      }
+
+      WHEN("Cloning a child, that shares a unit with its own child") {
+         auto child1 = root.GetNamedChild("Child1");
+         auto grandchild1 = child1->GetNamedChild("GrandChild1");
+         grandchild1->AddUnit(child1->GetUnit<TestUnit1>());
+         auto copies = child1->CloneN(1, &root);
+
+         REQUIRE(copies.GetCount() == 1);
+         auto copy = copies[0];
+         auto copiedGrandchild1 = copy->GetNamedChild("GrandChild1");
+         REQUIRE(copiedGrandchild1);
+         REQUIRE(copiedGrandchild1->HasUnits<TestUnit1>() == 1);
+         REQUIRE(copiedGrandchild1->GetUnit<TestUnit1>()
+              == copy->GetUnit<TestUnit1>());
+         REQUIRE(copy->GetUnit<TestUnit1>() != child1->GetUnit<TestUnit1>());
+         REQUIRE(copy->GetUnit<TestUnit1>()->GetOwners().GetCount() == 2);
+      }
+
+      WHEN("Creating children repeatedly, from a compiled descriptor") {
+         Many childDescriptor = Construct::From<Thing>(
+            Traits::Name {"Prefabricated"},
+            Construct::From<TestUnit1>(),
+            Construct::From<Thing>(Traits::Name {"Inner"})
+         );
+
+         const auto prefabsBefore = root.GetRuntime()->GetPrefabCount();
+         const auto prefab = root.GetRuntime()->GetPrefab(childDescriptor);
+         REQUIRE(prefab->IsCacheable());
+         REQUIRE(prefab->GetProgram().size() == 7);
+         REQUIRE(prefab->GetCapacity().mChildren == 1);
+         REQUIRE(prefab->GetCapacity().mUnits == 0);
+         REQUIRE(prefab->GetProgram()[0].mCapacity.mChildren == 1);
+         REQUIRE(prefab->GetProgram()[0].mCapacity.mUnits == 1);
+         REQUIRE(root.GetRuntime()->GetPrefab(childDescriptor) == prefab);
+         REQUIRE(root.GetRuntime()->GetPrefabCount() == prefabsBefore + 1);
+
+         for (int i = 0; i < 5; ++i) {
+            Verbs::Create creator {childDescriptor};
+            root.Create(creator);
+            REQUIRE(creator.GetOutput().GetCount() == 1);
+         }
+
+         REQUIRE(root.GetRuntime()->GetPrefabCount() == prefabsBefore + 1);
+         REQUIRE(root.GetChildren().GetCount() == 8);
+         for (Offset i = 3; i < 8; ++i) {
+            auto child = root.GetChildren()[i];
+            REQUIRE(child->GetOwner() == &root);
+            REQUIRE(child->GetName() == "Prefabricated");
+            REQUIRE(child->HasUnits<TestUnit1>() == 1);
+            REQUIRE(child->GetChildren().GetCount() == 1);
+            REQUIRE(child->GetNamedChild("Inner"));
+         }
+      }
+
+      WHEN("Caching more prefabs than the cache can hold") {
+         auto& runtime = *root.GetRuntime();
+         REQUIRE(runtime.GetPrefabCapacity() == Runtime::DefaultPrefabCapacity);
+         runtime.SetPrefabCapacity(2);
+         REQUIRE(runtime.GetPrefabCount() <= 2);
+
+         Many descriptors[3] {
+            Construct::From<Thing>(Traits::Name {"First"}),
+            Construct::From<Thing>(Traits::Name {"Second"}),
+            Construct::From<Thing>(Traits::Name {"Third"})
+         };
+
+         const auto first = runtime.GetPrefab(descriptors[0]);
+         const auto second = runtime.GetPrefab(descriptors[1]);
+         REQUIRE(runtime.GetPrefab(descriptors[0]) == first);
+         (void) runtime.GetPrefab(descriptors[2]);
+
+         REQUIRE(runtime.GetPrefabCount() == 2);
+         REQUIRE(runtime.GetPrefab(descriptors[1]) == second);
+         REQUIRE(runtime.GetPrefab(descriptors[0]) != first);
+
+         runtime.SetPrefabCapacity(0);
+         REQUIRE(runtime.GetPrefabCount() == 0);
+         REQUIRE(runtime.GetPrefab(descriptors[0])->IsCacheable());
+         REQUIRE(runtime.GetPrefabCount() == 0);
+      }
+
+      WHEN("Filtering by the type mask") {
+         const auto& mask = root.GetTypeMask();
+         REQUIRE(mask.MayContain(Entity::GetTypeIndex<Traits::Name>()));
+         REQUIRE(mask.MayContain(Entity::GetTypeIndex<TestUnit1>()));
+         REQUIRE(mask.MayContain(Entity::GetTypeIndex<TestUnit2>()));
+         REQUIRE(Entity::GetTypeIndex<TestUnit1>()
+              == Entity::GetTypeIndex(MetaDataOf<TestUnit1>()));
+
+         auto child2 = root.GetNamedChild("Child2");
+         REQUIRE(child2->GetTypeMask().MayContain(Entity::GetTypeIndex<Traits::Name>()));
+         REQUIRE(not child2->GetTypeMask().MayContain(Entity::GetTypeIndex<TestUnit1>()));
+         REQUIRE(not child2->GetTypeMask().MayContainAll(mask));
+         REQUIRE(child2->HasUnits<TestUnit1>() == 0);
+
+         root.RemoveUnits<TestUnit1>();
+         REQUIRE(not root.GetTypeMask().MayContain(Entity::GetTypeIndex<TestUnit1>()));
+         REQUIRE(root.GetTypeMask().MayContain(Entity::GetTypeIndex<TestUnit2>()));
+
+         root.RemoveTrait(MetaTraitOf<Traits::Name>());
+         REQUIRE(not root.GetTypeMask().MayContain(Entity::GetTypeIndex<Traits::Name>()));
+         REQUIRE(not root.GetName());
+      }
+
+      WHEN("Filtering by type indices beyond the mask capacity") {
+         constexpr auto capacity = Entity::TypeMask::Capacity;
+         Entity::TypeMask mask;
+         mask.Set(capacity + 3);
+         REQUIRE(mask.MayContain(capacity + 3));
+         REQUIRE(mask.MayContain(3));
+         REQUIRE(not mask.MayContain(capacity + 4));
+         REQUIRE(not mask.MayContain(capacity * 2 + 5));
+      }
+
       WHEN("Getting a local child by index") {
          auto child = root.GetChild(0);
          auto child1 = root.GetChildren()[0];
@@ -356,6 +504,40 @@ TEMPLATE_TEST_CASE("Testing Thing with different kidns of descriptors",
          REQUIRE(child3 == child);
       }
 
+      WHEN("Getting a local child by name, next to unnamed children with units") {
+         auto unnamed = root.CreateChild();
+         unnamed->CreateUnit<TestUnit1>();
+         root.GetChildren()[1]->SetName("Child4");
+
+         REQUIRE(root.GetNamedChild("Child2") == root.GetChildren()[2]);
+         REQUIRE(root.GetNamedChild("Child2", 1) == nullptr);
+         REQUIRE(root.GetNamedChild("Child4") == root.GetChildren()[1]);
+         REQUIRE(root.GetNamedChild("Missing") == nullptr);
+
+         unnamed->SetName("Child2");
+         REQUIRE(root.GetNamedChild("Child2", 1) == unnamed);
+      }
+
+      WHEN("Finding descendants by path, before and after renaming") {
+         auto grandChild2 = root.GetChildren()[0]->GetChildren()[1];
+         REQUIRE(root.FindByPath("Child1/GrandChild2") == grandChild2);
+         REQUIRE(root.FindByPath("/Child1//GrandChild2/") == grandChild2);
+         REQUIRE(root.FindByPath("Child1/Missing") == nullptr);
+         REQUIRE(root.FindByPath("") == &root);
+
+         // Renaming the second Child2 makes the first one the only match
+         root.GetChildren()[2]->SetName("Child3");
+         REQUIRE(root.GetNamedChild("Child2") == root.GetChildren()[1]);
+         REQUIRE(root.GetNamedChild("Child2", 1) == nullptr);
+         REQUIRE(root.GetNamedChild("Child3") == root.GetChildren()[2]);
+
+         // Renaming the first one too keeps the order of the children      
+         root.GetChildren()[1]->SetName("Child3");
+         REQUIRE(root.GetNamedChild("Child3") == root.GetChildren()[1]);
+         REQUIRE(root.GetNamedChild("Child3", 1) == root.GetChildren()[2]);
+         REQUIRE(root.GetNamedChild("Child2") == nullptr);
+      }
+
       WHEN("Get a local unit by index") {
          // Hash algorithm changes might swap the order of these two    
          auto unit0 = root.GetUnit(0);
@@ -419,6 +601,131 @@ TEMPLATE_TEST_CASE("Testing Thing with different kidns of descriptors",
          REQUIRE(found1.GetCount() == 1);
       }
 
+      WHEN("Visiting units in the hierarchy, with and without an early exit") {
+         Count visited = 0;
+         const auto all = root.ForEachUnit<TestUnit1, Seek::HereAndBelow>(
+            [&](TestUnit1* unit) {
+               REQUIRE(unit);
+               ++visited;
+            }
+         );
+
+         REQUIRE(all == 2);
+         REQUIRE(visited == 2);
+
+         visited = 0;
+         const auto first = root.ForEachUnit<TestUnit1, Seek::HereAndBelow>(
+            [&](TestUnit1*) {
+               ++visited;
+               return Loop::Break;
+            }
+         );
+
+         REQUIRE(first == 1);
+         REQUIRE(visited == 1);
+      }
+
+      WHEN("Gathering units below, through the runtime's unit registry") {
+         auto child1 = root.GetNamedChild("Child1");
+         const auto& registered = root.GetRuntime()->GetRegisteredUnits(MetaOf<TestUnit1>());
+
+         REQUIRE(registered.GetCount() == 2);
+         REQUIRE(root.GatherUnits<TestUnit1, Seek::HereAndBelow>().GetCount() == 2);
+         REQUIRE(root.GatherUnits<TestUnit1, Seek::Below>().GetCount() == 1);
+         REQUIRE(child1->GatherUnits<TestUnit1, Seek::HereAndBelow>().GetCount() == 1);
+         REQUIRE(child1->GatherUnits<TestUnit1, Seek::Below>().GetCount() == 0);
+
+         child1->RemoveUnits<TestUnit1>();
+
+         REQUIRE(root.GetRuntime()->GetRegisteredUnits(MetaOf<TestUnit1>()).GetCount() == 1);
+         REQUIRE(root.GatherUnits<TestUnit1, Seek::HereAndBelow>().GetCount() == 1);
+         REQUIRE(root.GatherUnits<TestUnit1, Seek::Below>().GetCount() == 0);
+      }
+
+      WHEN("Unregistering units out of registration order") {
+         auto child2 = root.GetNamedChild("Child2");
+         auto a = child2->CreateChild(Construct::From<TestUnit1>());
+         auto b = child2->CreateChild(Construct::From<TestUnit1>());
+         auto c = child2->CreateChild(Construct::From<TestUnit1>());
+         REQUIRE(root.GetRuntime()->GetRegisteredUnits(MetaOf<TestUnit1>()).GetCount() == 5);
+
+         const auto inC = c->GetUnit<TestUnit1>();
+         b->RemoveUnits<TestUnit1>();
+         a->RemoveUnits<TestUnit1>();
+
+         const auto& registered = root.GetRuntime()->GetRegisteredUnits(MetaOf<TestUnit1>());
+         REQUIRE(registered.GetCount() == 3);
+         Count matches = 0;
+         for (auto& entry : registered)
+            matches += entry.mUnit == inC and entry.mOwner == &*c;
+         REQUIRE(matches == 1);
+         REQUIRE(child2->GatherUnits<TestUnit1, Seek::Below>().GetCount() == 1);
+
+         c->RemoveUnits<TestUnit1>();
+         REQUIRE(root.GetRuntime()->GetRegisteredUnits(MetaOf<TestUnit1>()).GetCount() == 2);
+      }
+
+      WHEN("Gathering units below, that were added out of hierarchy order") {
+         auto child2 = root.GetNamedChild("Child2");
+         auto a = child2->CreateChild();
+         auto b = child2->CreateChild();
+         auto c = child2->CreateChild();
+         c->CreateUnit<TestUnit1>();
+         a->CreateUnit<TestUnit1>();
+         b->CreateUnit<TestUnit1>();
+
+         // The registry is used from the runtime's owner, but units    
+         // come in the same order as when walking the children         
+         TMany<A::Unit*> walked;
+         for (auto child : root.GetChildren()) {
+            for (auto unit : child->GatherUnits<TestUnit1, Seek::HereAndBelow>())
+               walked << unit;
+         }
+
+         const auto gathered = root.GatherUnits<TestUnit1, Seek::Below>();
+         REQUIRE(gathered.GetCount() == 4);
+         REQUIRE(gathered == walked);
+         REQUIRE(gathered[1] == a->GetUnit<TestUnit1>());
+         REQUIRE(gathered[3] == c->GetUnit<TestUnit1>());
+      }
+
+      WHEN("Seeking a unit upwards, before and after the hierarchy changes") {
+         auto child1 = root.GetNamedChild("Child1");
+         auto grandchild1 = child1->GetNamedChild("GrandChild1");
+         auto inChild = child1->GetUnitMeta(MetaOf<TestUnit1>());
+         auto inRoot = root.GetUnitMeta(MetaOf<TestUnit1>());
+
+         REQUIRE(inChild != inRoot);
+         REQUIRE(grandchild1->SeekUnit(MetaOf<TestUnit1>()) == inChild);
+         REQUIRE(grandchild1->SeekUnit(MetaOf<TestUnit1>()) == inChild);
+
+         child1->RemoveUnits<TestUnit1>();
+         REQUIRE(grandchild1->SeekUnit(MetaOf<TestUnit1>()) == inRoot);
+         REQUIRE(grandchild1->SeekUnit(MetaOf<TestUnit1>()) == inRoot);
+      }
+
+      WHEN("Seeking a unit upwards, while other branches and owners change") {
+         auto child1 = root.GetNamedChild("Child1");
+         auto child2 = root.GetNamedChild("Child2");
+         auto grandchild1 = child1->GetNamedChild("GrandChild1");
+         auto inChild = child1->GetUnitMeta(MetaOf<TestUnit1>());
+         auto inRoot = root.GetUnitMeta(MetaOf<TestUnit1>());
+         REQUIRE(grandchild1->SeekUnit(MetaOf<TestUnit1>()) == inChild);
+
+         // Changes in another branch don't affect the owners           
+         child2->AddTrait(Traits::Count {1});
+         child2->CreateChild(Traits::Name {"Unrelated"});
+         REQUIRE(grandchild1->SeekUnit(MetaOf<TestUnit1>()) == inChild);
+
+         // Moving the seeker changes its owners                        
+         child2->AddChild(grandchild1);
+         REQUIRE(grandchild1->SeekUnit(MetaOf<TestUnit1>()) == inRoot);
+
+         // So does a change in any of its new owners                   
+         root.RemoveUnits<TestUnit1>();
+         REQUIRE(grandchild1->SeekUnit(MetaOf<TestUnit1>()) == nullptr);
+      }
+
       /*WHEN("Seek a unit by index") {
          auto unit = root.SeekUnit(0);
       }
@@ -445,4 +752,355 @@ TEMPLATE_TEST_CASE("Testing Thing with different kidns of descriptors",
    }
 
    REQUIRE(memoryState.Assert());
-}
\ No newline at end of file
+}
+
+SCENARIO("Seeking values, that need conversion", "[thing]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A Thing with a child and a numeric trait") {
+      Thing root;
+      root.AddTrait(Traits::Count {5});
+      auto child = root.CreateChild();
+
+      WHEN("Seeking a value, that converts") {
+         Real value {};
+         REQUIRE(child->SeekValue<Traits::Count>(value));
+         REQUIRE(value == 5);
+         REQUIRE(Entity::GetConversion(MetaDataOf<int>(), MetaDataOf<Real>())
+            == Entity::Conversion::Possible);
+      }
+
+      WHEN("Converting data, that doesn't convert") {
+         Many data = MetaDataOf<int>();
+         Real value {};
+         REQUIRE(not Entity::TryConvert(data, value));
+         REQUIRE(Entity::GetConversion(MetaDataOf<DMeta>(), MetaDataOf<Real>())
+            == Entity::Conversion::Impossible);
+         REQUIRE(not Entity::TryConvert(data, value));
+         REQUIRE(value == 0);
+      }
+
+      WHEN("Converting data, whose conversion depends on its contents") {
+         Many data = Text {"not a number"};
+         Real value {};
+         REQUIRE(not Entity::TryConvert(data, value));
+         REQUIRE(Entity::GetConversion(MetaDataOf<Text>(), MetaDataOf<Real>())
+            == Entity::Conversion::Unknown);
+
+         Many numbers;
+         numbers << 1 << 2;
+         (void) Entity::TryConvert(numbers, value);
+         REQUIRE(Entity::GetConversion(MetaDataOf<int>(), MetaDataOf<Real>())
+            == Entity::Conversion::Unknown);
+      }
+   }
+
+   Entity::ResetConversions();
+   REQUIRE(memoryState.Assert());
+}
+
+SCENARIO("Refreshing only the changed parts of the hierarchy", "[thing]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A root with two branches, with units that seek different traits") {
+      Thing root;
+      auto seeker = root.CreateChild();
+      seeker->CreateUnit<TestUnit1>();
+      auto bystander = root.CreateChild();
+      bystander->CreateUnit<TestUnit1>();
+      auto leaf = bystander->CreateChild();
+      leaf->CreateUnit<TestUnit1>();
+
+      // Units are refreshed at least once, regardless of dependencies  
+      root.Refresh();
+      REQUIRE(not root.RequiresRefreshBelow());
+
+      const auto seekerUnit = seeker->GetUnit<TestUnit1>();
+      const auto bystanderUnit = bystander->GetUnit<TestUnit1>();
+      const auto leafUnit = leaf->GetUnit<TestUnit1>();
+      REQUIRE(seekerUnit->mRefreshes == 1);
+      REQUIRE(bystanderUnit->mRefreshes == 1);
+      REQUIRE(leafUnit->mRefreshes == 1);
+
+      (void) seekerUnit->SeekTrait<Traits::Count>();
+      (void) leafUnit->SeekTrait<Traits::Name>();
+      REQUIRE(seekerUnit->GetDependencies().MayContain(
+         Entity::GetTypeIndex<Traits::Count>()));
+      REQUIRE(bystanderUnit->GetDependencies().IsEmpty());
+
+      WHEN("A branch is cleared") {
+         bystander->Clear();
+         REQUIRE(bystander->RequiresRefresh());
+         REQUIRE(root.RequiresRefreshBelow());
+         REQUIRE(not leaf->GetOwner());
+
+         // The detached leaf can be adopted and removed again          
+         REQUIRE(seeker->AddChild(&*leaf) == 1);
+         REQUIRE(seeker->GetChild(0) == &*leaf);
+         REQUIRE(seeker->RemoveChild(&*leaf) == 1);
+         REQUIRE(not seeker->GetChildren());
+      }
+
+      WHEN("A trait changes in a leaf") {
+         leaf->AddTrait(Traits::Name {"Leaf"});
+         REQUIRE(leaf->RequiresRefresh());
+         REQUIRE(not bystander->RequiresRefresh());
+         REQUIRE(bystander->RequiresRefreshBelow());
+         REQUIRE(root.RequiresRefreshBelow());
+
+         root.Refresh();
+         REQUIRE(not root.RequiresRefreshBelow());
+         REQUIRE(leafUnit->mRefreshes == 2);
+         REQUIRE(bystanderUnit->mRefreshes == 1);
+         REQUIRE(seekerUnit->mRefreshes == 1);
+
+         // Dependencies are recorded anew on each refresh              
+         REQUIRE(leafUnit->GetDependencies().IsEmpty());
+      }
+
+      WHEN("A trait, that nobody seeks, changes in a leaf") {
+         leaf->AddTrait(Traits::Count {1});
+         root.Refresh();
+         REQUIRE(not leaf->RequiresRefresh());
+         REQUIRE(leafUnit->mRefreshes == 1);
+      }
+
+      WHEN("A sought trait changes in the root") {
+         root.AddTrait(Traits::Count {5});
+         root.Refresh();
+         REQUIRE(seekerUnit->mRefreshes == 2);
+         REQUIRE(bystanderUnit->mRefreshes == 1);
+         REQUIRE(leafUnit->mRefreshes == 1);
+      }
+
+      WHEN("Refresh is forced") {
+         root.Refresh(true);
+         REQUIRE(seekerUnit->mRefreshes == 2);
+         REQUIRE(bystanderUnit->mRefreshes == 2);
+         REQUIRE(leafUnit->mRefreshes == 2);
+      }
+   }
+
+   REQUIRE(memoryState.Assert());
+}
+
+SCENARIO("Adding and removing children and units by slot", "[thing]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A root with five children and two units") {
+      Thing root;
+      Ref<Thing> children[5];
+      for (auto& child : children)
+         child = root.CreateChild();
+      root.CreateUnit<TestUnit1>();
+      root.CreateUnit<TestUnit2>();
+      const auto unit1 = root.GetUnit<TestUnit1>();
+      const auto unit2 = root.GetUnit<TestUnit2>();
+
+      REQUIRE(root.HasChild(&*children[3]));
+      REQUIRE(not children[3]->HasChild(&root));
+      REQUIRE(root.AddChild(&*children[3]) == 0);
+      REQUIRE(root.AddUnit(unit1) == 0);
+
+      WHEN("A child and a unit are removed in order") {
+         REQUIRE(root.RemoveChild(&*children[1]) == 1);
+         REQUIRE(root.RemoveChild(&*children[1]) == 0);
+         REQUIRE(not root.HasChild(&*children[1]));
+         REQUIRE(root.GetChildren().GetCount() == 4);
+         REQUIRE(root.GetChild(1) == &*children[2]);
+         REQUIRE(root.GetChild(3) == &*children[4]);
+         REQUIRE(root.HasChild(&*children[4]));
+
+         REQUIRE(root.RemoveUnit(unit1) == 1);
+         REQUIRE(root.RemoveUnit(unit1) == 0);
+         REQUIRE(root.GetUnits().GetCount() == 1);
+         REQUIRE(root.GetUnits()[0] == unit2);
+         REQUIRE(root.RemoveUnit(unit2) == 1);
+      }
+
+      WHEN("A child is removed without preserving order") {
+         root.SetUnorderedRemoval(true);
+         REQUIRE(root.RemoveChild(&*children[1]) == 1);
+         REQUIRE(root.GetChildren().GetCount() == 4);
+         REQUIRE(root.GetChild(1) == &*children[4]);
+         REQUIRE(root.GetChild(3) == &*children[3]);
+         REQUIRE(root.HasChild(&*children[4]));
+
+         REQUIRE(root.RemoveChild(&*children[4]) == 1);
+         REQUIRE(root.GetChild(1) == &*children[3]);
+         REQUIRE(root.HasChild(&*children[3]));
+      }
+
+      WHEN("Named children are removed without preserving order") {
+         root.SetUnorderedRemoval(true);
+         children[1]->SetName("Same");
+         children[2]->SetName("Same");
+         children[4]->SetName("Same");
+
+         // The last child is moved before the other one named "Same"   
+         REQUIRE(root.RemoveChild(&*children[0]) == 1);
+         REQUIRE(root.GetChild(0) == &*children[4]);
+         REQUIRE(root.GetNamedChild("Same", 0) == &*children[4]);
+         REQUIRE(root.GetNamedChild("Same", 1) == &*children[1]);
+         REQUIRE(root.GetNamedChild("Same", 2) == &*children[2]);
+      }
+
+      WHEN("A child is moved to another parent") {
+         auto other = root.CreateChild();
+         REQUIRE(other->AddChild(&*children[2]) == 1);
+         REQUIRE(not root.HasChild(&*children[2]));
+         REQUIRE(other->HasChild(&*children[2]));
+         REQUIRE(children[2]->GetOwner() == &*other);
+         REQUIRE(root.GetChild(2) == &*children[3]);
+      }
+   }
+
+   REQUIRE(memoryState.Assert());
+}
+
+SCENARIO("Selecting traits and units, filtered by type masks", "[thing]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A named root with a child, that has a unit") {
+      Thing root;
+      root.AddTrait(Traits::Name {"Root"});
+      auto child = root.CreateChild();
+      child->CreateUnit<TestUnit1>();
+
+      WHEN("Selecting a unit, that the child has") {
+         Verbs::Select selector {MetaDataOf<TestUnit1>()};
+         child->Select(selector);
+         REQUIRE(selector.IsDone());
+         REQUIRE(selector.GetOutput());
+      }
+
+      WHEN("Selecting a trait, that only the root has") {
+         Verbs::Select selector {MetaTraitOf<Traits::Name>()};
+         child->Select(selector);
+         REQUIRE(selector.IsDone());
+         REQUIRE(selector.GetOutput());
+      }
+
+      WHEN("Selecting a trait and a unit, that nobody has together") {
+         Verbs::Select selector {Many {
+            MetaTraitOf<Traits::Name>(), MetaDataOf<TestUnit1>()
+         }};
+         child->Select(selector);
+         REQUIRE(not selector.IsDone());
+      }
+
+      WHEN("Selecting a trait, that nobody has") {
+         Verbs::Select selector {MetaTraitOf<Traits::Count>()};
+         child->Select(selector);
+         REQUIRE(not selector.IsDone());
+      }
+   }
+
+   REQUIRE(memoryState.Assert());
+}
+
+SCENARIO("Building and tearing down a wide hierarchy", "[thing][!benchmark]") {
+   GIVEN("A number of children") {
+      constexpr Count count = 10000;
+
+      BENCHMARK_ADVANCED("Building a wide hierarchy") (timer meter) {
+         meter.measure([&] {
+            Thing root;
+            for (Count i = 0; i < count; ++i)
+               root.CreateChild();
+            return root.GetChildren().GetCount();
+         });
+      };
+
+      BENCHMARK_ADVANCED("Removing children in order") (timer meter) {
+         ::std::vector<Thing> roots(meter.runs());
+         for (auto& root : roots) {
+            for (Count i = 0; i < count; ++i)
+               root.CreateChild();
+         }
+
+         meter.measure([&](int i) {
+            auto& root = roots[i];
+            while (root.GetChildren())
+               root.RemoveChild(root.GetChild(0));
+            return root.GetChildren().GetCount();
+         });
+      };
+
+      BENCHMARK_ADVANCED("Removing children without preserving order") (timer meter) {
+         ::std::vector<Thing> roots(meter.runs());
+         for (auto& root : roots) {
+            root.SetUnorderedRemoval(true);
+            for (Count i = 0; i < count; ++i)
+               root.CreateChild();
+         }
+
+         meter.measure([&](int i) {
+            auto& root = roots[i];
+            while (root.GetChildren())
+               root.RemoveChild(root.GetChild(0));
+            return root.GetChildren().GetCount();
+         });
+      };
+   }
+}
+
+SCENARIO("Adding and removing many units", "[thing][!benchmark]") {
+   GIVEN("A number of units") {
+      constexpr Count count = 1000;
+
+      BENCHMARK_ADVANCED("Creating units") (timer meter) {
+         meter.measure([&] {
+            Thing root;
+            for (Count i = 0; i < count; ++i)
+               root.CreateUnit<TestUnit1>();
+            return root.GetUnits().GetCount();
+         });
+      };
+
+      BENCHMARK_ADVANCED("Adding the same units to other Things") (timer meter) {
+         Thing source;
+         for (Count i = 0; i < count; ++i)
+            source.CreateUnit<TestUnit1>();
+
+         ::std::vector<Thing> targets(meter.runs());
+         meter.measure([&](int i) {
+            auto& target = targets[i];
+            for (auto unit : source.GetUnits())
+               target.AddUnit(unit);
+            return target.GetUnits().GetCount();
+         });
+      };
+
+      BENCHMARK_ADVANCED("Removing units in order") (timer meter) {
+         ::std::vector<Thing> roots(meter.runs());
+         for (auto& root : roots) {
+            for (Count i = 0; i < count; ++i)
+               root.CreateUnit<TestUnit1>();
+         }
+
+         meter.measure([&](int i) {
+            auto& root = roots[i];
+            while (root.GetUnits())
+               root.RemoveUnit(root.GetUnits()[0]);
+            return root.GetUnits().GetCount();
+         });
+      };
+
+      BENCHMARK_ADVANCED("Removing units without preserving order") (timer meter) {
+         ::std::vector<Thing> roots(meter.runs());
+         for (auto& root : roots) {
+            root.SetUnorderedRemoval(true);
+            for (Count i = 0; i < count; ++i)
+               root.CreateUnit<TestUnit1>();
+         }
+
+         meter.measure([&](int i) {
+            auto& root = roots[i];
+            while (root.GetUnits())
+               root.RemoveUnit(root.GetUnits()[0]);
+            return root.GetUnits().GetCount();
+         });
+      };
+   }
+}
@@ -22,4 +22,18 @@ SCENARIO("Testing Unit", "[unit]") {
       REQUIRE(dynamic_cast<TestUnit2*>(t2p) == &t2);
       REQUIRE(dynamic_cast<TestUnit1*>(t2p) == nullptr);
    }
+
+   WHEN("Flattening the bases of a unit type") {
+      const auto& bases = Entity::GetBaseList<A::Unit>(MetaDataOf<TestUnit1>());
+
+      REQUIRE(bases.size() == 1);
+      REQUIRE(bases[0] == MetaDataOf<TestUnit1>());
+      REQUIRE(&Entity::GetBaseList<A::Unit>(MetaDataOf<TestUnit1>()) == &bases);
+
+      Entity::ResetBaseLists();
+      const auto& rebuilt = Entity::GetBaseList<A::Unit>(MetaDataOf<TestUnit1>());
+      REQUIRE(&rebuilt != &bases);
+      REQUIRE(rebuilt == bases);
+      REQUIRE(bases[0] == MetaDataOf<TestUnit1>());
+   }
 }
\ No newline at end of file